@@ -0,0 +1,288 @@
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cixl/box.h"
+#include "cixl/cx.h"
+#include "cixl/env.h"
+#include "cixl/error.h"
+#include "cixl/func.h"
+#include "cixl/lib.h"
+#include "cixl/ls.h"
+#include "cixl/malloc.h"
+#include "cixl/scope.h"
+#include "cixl/set.h"
+#include "cixl/timer.h"
+#include "cixl/vec.h"
+
+#define MIN_OPS 1000000
+#define MAX_SCALE 1000000
+#define MAX_RANDOM_INSERT 100000
+#define MAX_ENV 1000
+#define MAX_FIMPS 1000
+
+static const char *filter = NULL;
+
+static void report(const char *id, size_t n, size_t nops, int64_t ns) {
+  printf("%-20s %8zd %10.2f ns/op\n", id, n, (double)ns / nops);
+  fflush(stdout);
+}
+
+static size_t reps(size_t n) {
+  return (n < MIN_OPS) ? MIN_OPS / n : 1;
+}
+
+static bool run(const char *id) {
+  return !filter || strstr(id, filter);
+}
+
+static int64_t *shuffled(size_t n) {
+  int64_t *ks = malloc(n*sizeof(int64_t));
+  for (size_t i = 0; i < n; i++) { ks[i] = i; }
+
+  for (size_t i = n-1; i > 0; i--) {
+    size_t j = rand() % (i+1);
+    int64_t k = ks[i];
+    ks[i] = ks[j];
+    ks[j] = k;
+  }
+
+  return ks;
+}
+
+static void vec_push_pop(size_t n) {
+  struct cx_vec v;
+  cx_vec_init(&v, sizeof(int64_t));
+  size_t nreps = reps(n);
+  cx_timer_t t;
+  cx_timer_reset(&t);
+
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) { *(int64_t *)cx_vec_push(&v) = i; }
+    while (v.count) { cx_vec_pop(&v); }
+  }
+
+  report("vec push/pop", n, 2*n*nreps, cx_timer_ns(&t));
+  cx_vec_deinit(&v);
+}
+
+static void set_ops(size_t n) {
+  struct cx_set s;
+  cx_set_init(&s, sizeof(int64_t), cx_cmp_int);
+  int64_t *ks = shuffled(n);
+  size_t nreps = reps(n);
+  cx_timer_t t;
+
+  cx_timer_reset(&t);
+
+  for (size_t r = 0; r < nreps; r++) {
+    cx_set_clear(&s);
+
+    for (int64_t i = 0; i < (int64_t)n; i++) {
+      *(int64_t *)cx_set_insert(&s, &i) = i;
+    }
+  }
+
+  report("set insert seq", n, n*nreps, cx_timer_ns(&t));
+
+  if (n <= MAX_RANDOM_INSERT) {
+    cx_timer_reset(&t);
+
+    for (size_t r = 0; r < nreps; r++) {
+      cx_set_clear(&s);
+
+      for (size_t i = 0; i < n; i++) {
+	*(int64_t *)cx_set_insert(&s, ks+i) = ks[i];
+      }
+    }
+
+    report("set insert rnd", n, n*nreps, cx_timer_ns(&t));
+  }
+
+  cx_timer_reset(&t);
+  size_t nfound = 0;
+
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) {
+      if (cx_set_get(&s, ks+i)) { nfound++; }
+    }
+  }
+
+  report("set find", n, n*nreps, cx_timer_ns(&t));
+  if (nfound != n*nreps) { fputs("Missing set members\n", stderr); }
+
+  // Deleting from the back avoids measuring memmove only
+
+  cx_timer_reset(&t);
+
+  for (int64_t i = n-1; i >= 0; i--) { cx_set_delete(&s, &i); }
+  report("set delete", n, n, cx_timer_ns(&t));
+
+  free(ks);
+  cx_set_deinit(&s);
+}
+
+static void env_ops(struct cx *cx, size_t n) {
+  struct cx_malloc alloc;
+  cx_malloc_init(&alloc, CX_SLAB_SIZE, sizeof(struct cx_var));
+  struct cx_env env;
+  cx_env_init(&env, &alloc);
+
+  struct cx_sym *ids = malloc(n*sizeof(struct cx_sym));
+  int64_t *ks = shuffled(n);
+
+  // Tags collide on every CX_ENV_SLOTS:th value, chains grow with n
+
+  for (size_t i = 0; i < n; i++) {
+    ids[i].id = ids[i].emit_id = NULL;
+    ids[i].tag = ks[i];
+  }
+
+  size_t nreps = reps(n);
+  cx_timer_t t;
+  cx_timer_reset(&t);
+
+  for (size_t r = 0; r < nreps; r++) {
+    cx_env_clear(&env);
+
+    for (size_t i = 0; i < n; i++) {
+      cx_box_init(cx_env_put(&env, ids[i]), cx->int_type)->as_int = i;
+    }
+  }
+
+  report("env put", n, n*nreps, cx_timer_ns(&t));
+  cx_timer_reset(&t);
+  size_t nfound = 0;
+
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) {
+      if (cx_env_get(&env, ids[n-i-1])) { nfound++; }
+    }
+  }
+
+  report("env get", n, n*nreps, cx_timer_ns(&t));
+  if (nfound != n*nreps) { fputs("Missing env vars\n", stderr); }
+
+  free(ks);
+  free(ids);
+  cx_env_deinit(&env);
+  cx_malloc_deinit(&alloc);
+}
+
+static bool match_imp(struct cx_call *call) { return true; }
+
+static void func_match(struct cx *cx, size_t n) {
+  struct cx_lib *lib = *cx->lib;
+  struct cx_type **types = malloc(n*sizeof(struct cx_type *));
+  char *func_id = cx_fmt("micro-match%zd", n);
+  
+  for (size_t i = 0; i < n; i++) {
+    char *id = cx_fmt("Micro%zd-%zd", n, i);
+    types[i] = cx_add_type(lib, id, cx->any_type);
+    free(id);
+    
+    cx_add_cfunc(lib, func_id,
+		 cx_args(cx_arg("x", types[i])),
+		 cx_args(),
+		 match_imp);
+  }
+
+  struct cx_func *func = cx_get_func(cx, func_id, false);
+  struct cx_scope *s = cx_scope(cx, 0);
+  int64_t *ks = shuffled(n);
+  size_t nreps = reps(n), nfound = 0;
+  cx_timer_t t;
+  
+  // Bumping the epoch empties dispatch tables, every match scores all imps
+
+  cx_timer_reset(&t);
+  
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) {
+      cx->dispatch_epoch++;
+      cx_box_init(cx_push(s), types[ks[i]]);
+      if (cx_func_match(func, s)) { nfound++; }
+      s->stack.count--;
+    }
+  }
+
+  report("func match miss", n, n*nreps, cx_timer_ns(&t));
+  cx_timer_reset(&t);
+  
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) {
+      cx_box_init(cx_push(s), types[ks[i]]);
+      if (cx_func_match(func, s)) { nfound++; }
+      s->stack.count--;
+    }
+  }
+
+  report("func match hit", n, n*nreps, cx_timer_ns(&t));
+  if (nfound != 2*n*nreps) { fputs("Missing fimps\n", stderr); }
+  
+  free(ks);
+  free(func_id);
+  free(types);
+}
+
+static void malloc_churn(size_t n) {
+  struct cx_malloc alloc;
+  cx_malloc_init(&alloc, CX_SLAB_SIZE, sizeof(struct cx_box));
+  void **ps = malloc(n*sizeof(void *));
+  int64_t *ks = shuffled(n);
+  size_t nreps = reps(n);
+  cx_timer_t t;
+  cx_timer_reset(&t);
+
+  // Freeing in random order scatters the free list
+
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) { ps[i] = cx_malloc(&alloc); }
+    for (size_t i = 0; i < n; i++) { cx_free(&alloc, ps[ks[i]]); }
+  }
+
+  report("malloc/free", n, 2*n*nreps, cx_timer_ns(&t));
+  free(ks);
+  free(ps);
+  cx_malloc_deinit(&alloc);
+}
+
+static void ls_churn(size_t n) {
+  struct cx_ls root, *items = malloc(n*sizeof(struct cx_ls));
+  cx_ls_init(&root);
+  size_t nreps = reps(n);
+  cx_timer_t t;
+  cx_timer_reset(&t);
+
+  for (size_t r = 0; r < nreps; r++) {
+    for (size_t i = 0; i < n; i++) { cx_ls_prepend(&root, items+i); }
+    cx_do_ls(&root, i) { cx_ls_delete(i); }
+    cx_ls_init(&root);
+  }
+
+  report("ls prepend/delete", n, 2*n*nreps, cx_timer_ns(&t));
+  free(items);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1) { filter = argv[1]; }
+  srand(0);
+
+  struct cx cx;
+  cx_init(&cx);
+  cx_init_libs(&cx);
+  cx_use(&cx, "cx/abc");
+
+  for (size_t n = 10; n <= MAX_SCALE; n *= 10) {
+    if (run("vec")) { vec_push_pop(n); }
+    if (run("set")) { set_ops(n); }
+    if (run("env") && n <= MAX_ENV) { env_ops(&cx, n); }
+    if (run("func") && n <= MAX_FIMPS) { func_match(&cx, n); }
+    if (run("malloc")) { malloc_churn(n); }
+    if (run("ls")) { ls_churn(n); }
+  }
+
+  cx_deinit(&cx);
+  return 0;
+}
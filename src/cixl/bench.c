@@ -0,0 +1,262 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cixl/bench.h"
+#include "cixl/box.h"
+#include "cixl/cx.h"
+#include "cixl/error.h"
+#include "cixl/mfile.h"
+#include "cixl/scope.h"
+#include "cixl/timer.h"
+#include "cixl/util.h"
+
+struct cx_bench *cx_bench_init(struct cx_bench *b, const char *id) {
+  b->id = strdup(id);
+  cx_vec_init(&b->samples, sizeof(int64_t));
+  b->median = b->mad = 0;
+  return b;
+}
+
+struct cx_bench *cx_bench_deinit(struct cx_bench *b) {
+  free(b->id);
+  cx_vec_deinit(&b->samples);
+  return b;
+}
+
+bool cx_bench_call(struct cx_bench *b,
+		   int warmup, int reps,
+		   struct cx_box *act,
+		   struct cx_scope *scope) {
+  for (int i = 0; i < warmup; i++) {
+    if (!cx_call(act, scope)) { return false; }
+  }
+
+  for (int i = 0; i < reps; i++) {
+    cx_timer_t t;
+    cx_timer_reset(&t);
+    if (!cx_call(act, scope)) { return false; }
+    cx_bench_add(b, cx_timer_ns(&t));
+  }
+
+  cx_bench_stats(b);
+  return true;
+}
+
+void cx_bench_add(struct cx_bench *b, int64_t sample) {
+  *(int64_t *)cx_vec_push(&b->samples) = sample;
+}
+
+void cx_bench_stats(struct cx_bench *b) {
+  size_t n = b->samples.count;
+
+  if (!n) {
+    b->median = b->mad = 0;
+    return;
+  }
+  
+  int64_t *xs = malloc(n*sizeof(int64_t));
+  memcpy(xs, b->samples.items, n*sizeof(int64_t));
+  b->median = cx_median(xs, n);
+  b->mad = cx_mad(xs, n, b->median);
+  free(xs);
+}
+
+static int int64_order(const void *x, const void *y) {
+  int64_t xv = *(const int64_t *)x, yv = *(const int64_t *)y;
+  return (xv > yv) - (xv < yv);
+}
+
+int64_t cx_median(int64_t *xs, size_t n) {
+  if (!n) { return 0; }
+  qsort(xs, n, sizeof(int64_t), int64_order);
+  return (n % 2) ? xs[n/2] : (xs[n/2-1] + xs[n/2]) / 2;
+}
+
+int64_t cx_mad(int64_t *xs, size_t n, int64_t median) {
+  for (size_t i = 0; i < n; i++) { xs[i] = llabs(xs[i] - median); }
+  return cx_median(xs, n);
+}
+
+static bool run_file(struct cx *cx,
+		     const char *cmd,
+		     const char *path,
+		     int64_t *out) {
+  char *c = cx_fmt("%s '%s'", cmd, path);
+  FILE *p = popen(c, "r");
+  free(c);
+
+  if (!p) {
+    cx_error(cx, cx->row, cx->col, "Failed running '%s': %d", path, errno);
+    return false;
+  }
+
+  char line[256];
+  bool ok = false;
+
+  // Benchmarks print their result last
+
+  while (fgets(line, sizeof(line), p)) {
+    char *end = NULL;
+    int64_t v = strtoll(line, &end, 10);
+
+    if (end != line && (!*end || *end == '\n')) {
+      *out = v;
+      ok = true;
+    }
+  }
+
+  if (pclose(p) || !ok) {
+    cx_error(cx, cx->row, cx->col, "Failed running '%s'", path);
+    return false;
+  }
+
+  return true;
+}
+
+struct baseline {
+  char id[64];
+  int64_t median, mad;
+};
+
+static bool read_baseline(const char *path, struct cx_vec *out) {
+  FILE *f = fopen(path, "r");
+  if (!f) { return false; }
+  struct baseline b;
+
+  while (fscanf(f, "%63s %" SCNd64 " %" SCNd64, b.id, &b.median, &b.mad) == 3) {
+    *(struct baseline *)cx_vec_push(out) = b;
+  }
+
+  fclose(f);
+  return true;
+}
+
+static struct baseline *find_baseline(struct cx_vec *in, const char *id) {
+  cx_do_vec(in, struct baseline, b) {
+    if (strcmp(b->id, id) == 0) { return b; }
+  }
+
+  return NULL;
+}
+
+static bool is_regression(struct cx_bench *b, struct baseline *prev) {
+  int64_t
+    mad = (b->mad > prev->mad) ? b->mad : prev->mad,
+    limit = (3*mad > prev->median/20) ? 3*mad : prev->median/20;
+
+  return b->median - prev->median > limit;
+}
+
+static void write_json(struct cx_vec *benches,
+		       struct cx_vec *baseline,
+		       FILE *out) {
+  fputs("[", out);
+  char *sep = "";
+
+  cx_do_vec(benches, struct cx_bench, b) {
+    fprintf(out, "%s\n  {\"id\": \"%s\", \"samples\": [", sep, b->id);
+    sep = ",";
+    char *ssep = "";
+
+    cx_do_vec(&b->samples, int64_t, s) {
+      fprintf(out, "%s%" PRId64, ssep, *s);
+      ssep = ", ";
+    }
+
+    fprintf(out, "], \"median\": %" PRId64 ", \"mad\": %" PRId64,
+	    b->median, b->mad);
+
+    struct baseline *prev = find_baseline(baseline, b->id);
+
+    if (prev) {
+      fprintf(out, ", \"baseline\": %" PRId64 ", \"regression\": %s",
+	      prev->median, is_regression(b, prev) ? "true" : "false");
+    }
+
+    fputc('}', out);
+  }
+
+  fputs("\n]\n", out);
+}
+
+bool cx_bench_files(struct cx *cx,
+		    const char *cmd,
+		    char **files, int nfiles,
+		    const char *json_path,
+		    const char *baseline_path) {
+  struct cx_vec benches, baseline;
+  cx_vec_init(&benches, sizeof(struct cx_bench));
+  cx_vec_init(&baseline, sizeof(struct baseline));
+  bool has_baseline = baseline_path && read_baseline(baseline_path, &baseline);
+  bool ok = false;
+  size_t nregressions = 0;
+
+  printf("%-16s %10s %10s %10s\n", "Benchmark", "Median", "MAD", "Baseline");
+
+  for (char **f = files; f < files+nfiles; f++) {
+    const char *id = strrchr(*f, '/');
+    id = id ? id+1 : *f;
+    struct cx_bench *b = cx_bench_init(cx_vec_push(&benches), id);
+    int64_t v = 0;
+
+    for (int i = 0; i < CX_BENCH_WARMUP + CX_BENCH_REPS; i++) {
+      if (!run_file(cx, cmd, *f, &v)) { goto exit; }
+      if (i >= CX_BENCH_WARMUP) { cx_bench_add(b, v); }
+    }
+
+    cx_bench_stats(b);
+    printf("%-16s %10" PRId64 " %10" PRId64, b->id, b->median, b->mad);
+    struct baseline *prev = find_baseline(&baseline, b->id);
+
+    if (prev) {
+      bool r = is_regression(b, prev);
+      printf(" %10" PRId64 "%s", prev->median, r ? " regression" : "");
+      if (r) { nregressions++; }
+    }
+
+    fputc('\n', stdout);
+    fflush(stdout);
+  }
+
+  if (json_path) {
+    FILE *out = fopen(json_path, "w");
+
+    if (!out) {
+      cx_error(cx, cx->row, cx->col, "Failed opening '%s': %d", json_path, errno);
+      goto exit;
+    }
+
+    write_json(&benches, &baseline, out);
+    fclose(out);
+  }
+
+  if (baseline_path && !has_baseline) {
+    FILE *out = fopen(baseline_path, "w");
+
+    if (!out) {
+      cx_error(cx, cx->row, cx->col,
+	       "Failed opening '%s': %d", baseline_path, errno);
+      goto exit;
+    }
+
+    cx_do_vec(&benches, struct cx_bench, b) {
+      fprintf(out, "%s %" PRId64 " %" PRId64 "\n", b->id, b->median, b->mad);
+    }
+
+    fclose(out);
+  }
+
+  if (nregressions) {
+    fprintf(stderr, "%zd regression(s)\n", nregressions);
+    goto exit;
+  }
+
+  ok = true;
+ exit:
+  cx_do_vec(&benches, struct cx_bench, b) { cx_bench_deinit(b); }
+  cx_vec_deinit(&benches);
+  cx_vec_deinit(&baseline);
+  return ok;
+}
@@ -0,0 +1,43 @@
+#ifndef CX_BENCH_H
+#define CX_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "cixl/vec.h"
+
+#define CX_BENCH_WARMUP 1
+#define CX_BENCH_REPS 5
+
+struct cx;
+struct cx_box;
+struct cx_scope;
+
+struct cx_bench {
+  char *id;
+  struct cx_vec samples;
+  int64_t median, mad;
+};
+
+struct cx_bench *cx_bench_init(struct cx_bench *b, const char *id);
+struct cx_bench *cx_bench_deinit(struct cx_bench *b);
+
+bool cx_bench_call(struct cx_bench *b,
+		   int warmup, int reps,
+		   struct cx_box *act,
+		   struct cx_scope *scope);
+
+void cx_bench_add(struct cx_bench *b, int64_t sample);
+void cx_bench_stats(struct cx_bench *b);
+
+int64_t cx_median(int64_t *xs, size_t n);
+int64_t cx_mad(int64_t *xs, size_t n, int64_t median);
+
+bool cx_bench_files(struct cx *cx,
+		    const char *cmd,
+		    char **files, int nfiles,
+		    const char *json_path,
+		    const char *baseline_path);
+
+#endif
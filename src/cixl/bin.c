@@ -2,8 +2,12 @@
 #include "cixl/bin.h"
 #include "cixl/error.h"
 #include "cixl/func.h"
+#include "cixl/infer.h"
 #include "cixl/op.h"
+#include "cixl/peephole.h"
 #include "cixl/scope.h"
+#include "cixl/slots.h"
+#include "cixl/stats.h"
 #include "cixl/str.h"
 #include "cixl/tok.h"
 
@@ -11,14 +15,16 @@ struct cx_bin *cx_bin_new() {
   return cx_bin_init(malloc(sizeof(struct cx_bin)));
 }
 
-static bool eval(struct cx *cx, ssize_t stop_pc) {
+bool cx_loop_eval(struct cx *cx, ssize_t stop_pc) {
   if (!cx->bin->ops.count) { return true; }
 
   while (cx->pc < cx->bin->ops.count && cx->pc != stop_pc) {
     cx_init_ops(cx->bin);
     struct cx_op *op = cx_vec_get(&cx->bin->ops, cx->pc++);
+    cx->file = op->file;
     cx->row = op->row; cx->col = op->col;
-
+    cx_stat(op->type->nevals++);
+    
     if (cx->errors.count) {
       if (op->type->error_eval) { op->type->error_eval(op, cx->bin, cx); }
     } else {
@@ -29,14 +35,98 @@ static bool eval(struct cx *cx, ssize_t stop_pc) {
   return !cx->errors.count;
 }
 
+enum cx_code_label {CX_CEVAL, CX_CPUSH, CX_CJUMP, CX_CNOP, CX_CEXIT};
+
+static void thread_ops(struct cx_bin *bin, void **labels) {
+  cx_init_ops(bin);
+  cx_vec_clear(&bin->code);
+  cx_vec_grow(&bin->code, bin->ops.count+1);
+  
+  cx_do_vec(&bin->ops, struct cx_op, op) {
+    struct cx_bin_code *c = cx_vec_push(&bin->code);
+    c->op = op;
+
+    if (op->type == CX_OPUSH()) {
+      c->label = labels[CX_CPUSH];
+    } else if (op->type == CX_OJUMP()) {
+      c->label = labels[CX_CJUMP];
+    } else if (!op->type->eval) {
+      c->label = labels[CX_CNOP];
+    } else {
+      c->label = labels[CX_CEVAL];
+    }
+  }
+
+  struct cx_bin_code *c = cx_vec_push(&bin->code);
+  c->op = NULL;
+  c->label = labels[CX_CEXIT];
+}
+
+bool cx_thread_eval(struct cx *cx, ssize_t stop_pc) {
+  static void *labels[] = {
+    [CX_CEVAL] = &&op_eval,
+    [CX_CPUSH] = &&op_push,
+    [CX_CJUMP] = &&op_jump,
+    [CX_CNOP] = &&op_nop,
+    [CX_CEXIT] = &&exit
+  };
+
+  struct cx_bin *bin = cx->bin;
+  if (bin->code.count != bin->ops.count+1) { thread_ops(bin, labels); }
+  struct cx_bin_code *c = NULL;
+  if (cx->errors.count) { goto error; }
+  
+ next:
+  if (cx->pc == stop_pc) { goto exit; }
+  c = (struct cx_bin_code *)bin->code.items + cx->pc++;
+  cx_stat(if (c->op) { c->op->type->nevals++; });
+  goto *c->label;
+  
+ op_push:
+  cx_copy(cx_push(cx_scope(cx, 0)), &c->op->as_push.value);
+  goto next;
+
+ op_jump:
+  cx->pc = c->op->as_jump.pc;
+  goto next;
+
+ op_nop:
+  goto next;
+  
+ op_eval: {
+    struct cx_op *op = c->op;
+    cx->file = op->file;
+    cx->row = op->row; cx->col = op->col;
+    op->type->eval(op, bin, cx);
+    if (bin->code.count != bin->ops.count+1) { thread_ops(bin, labels); }
+    if (!cx->errors.count) { goto next; }
+  }
+  
+ error:
+  while (cx->pc < bin->ops.count && cx->pc != stop_pc) {
+    if (!cx->errors.count) { goto next; }
+    struct cx_op *op = cx_vec_get(&bin->ops, cx->pc++);
+    cx->file = op->file;
+    cx->row = op->row; cx->col = op->col;
+    cx_stat(op->type->nevals++);
+    if (op->type->error_eval) { op->type->error_eval(op, bin, cx); }
+    if (bin->code.count != bin->ops.count+1) { thread_ops(bin, labels); }
+  }
+  
+ exit:
+  return !cx->errors.count;
+}
+
 struct cx_bin *cx_bin_init(struct cx_bin *bin) {
   cx_vec_init(&bin->toks, sizeof(struct cx_tok));
   cx_vec_init(&bin->ops, sizeof(struct cx_op));
+  cx_vec_init(&bin->code, sizeof(struct cx_bin_code));
   cx_set_init(&bin->fimps, sizeof(struct cx_bin_fimp), cx_cmp_ptr);
   bin->fimps.key_offs = offsetof(struct cx_bin_fimp, imp);
+  bin->infer = NULL;
   bin->init_offs = 0;
   bin->nrefs = 1;
-  bin->eval = eval;
+  bin->eval = cx_thread_eval;
   return bin;
 }
 
@@ -44,6 +134,7 @@ struct cx_bin *cx_bin_deinit(struct cx_bin *bin) {
   cx_bin_clear(bin);
   cx_vec_deinit(&bin->toks);  
   cx_vec_deinit(&bin->ops);
+  cx_vec_deinit(&bin->code);
   cx_set_deinit(&bin->fimps);
   return bin;
 }
@@ -54,6 +145,8 @@ void cx_bin_clear(struct cx_bin *bin) {
 
   cx_do_vec(&bin->ops, struct cx_op, o) { cx_op_deinit(o); }
   cx_vec_clear(&bin->ops);
+  cx_vec_clear(&bin->code);
+  bin->init_offs = 0;
 }
 
 struct cx_bin *cx_bin_ref(struct cx_bin *bin) {
@@ -72,13 +165,14 @@ bool cx_compile(struct cx *cx,
 		struct cx_tok *end,
 		struct cx_bin *out) {
   size_t nerrors = cx->errors.count;
-  size_t tok_idx = out->toks.count;
+  size_t tok_idx = out->toks.count, start_pc = out->ops.count;
 
   for (struct cx_tok *t = start; t != end; t++) {
     cx_tok_copy(cx_vec_push(&out->toks), t);
   }
   
   size_t stop = out->toks.count;
+  cx->compile_depth++;
   
   while (tok_idx < stop) {
     struct cx_tok *tok = cx_vec_get(&out->toks, tok_idx);
@@ -86,13 +180,22 @@ bool cx_compile(struct cx *cx,
     
     if (!tok->type->compile) {
       cx_error(cx, tok->row, tok->col, "Invalid token: %s", tok->type->id);
+      cx->compile_depth--;
       return false;
     }
     
     tok_idx = tok->type->compile(out, tok_idx, cx);
   }
 
-  return cx->errors.count <= nerrors;
+  cx->compile_depth--;
+  bool ok = cx->errors.count <= nerrors;
+
+  if (ok && !cx->compile_depth) {
+    if (cx->peephole.enabled) { cx_peephole(cx, out, start_pc); }
+    cx_alloc_slots(cx, out, start_pc);
+  }
+  
+  return ok;
 }
 
 void cx_init_ops(struct cx_bin *bin) {
@@ -104,7 +207,10 @@ void cx_init_ops(struct cx_bin *bin) {
 	? cx_vec_get(&bin->toks, op->tok_idx)
 	: NULL;
       
-      if (tok) { op->row = tok->row; op->col = tok->col; }
+      if (tok) {
+	op->file = tok->file;
+	op->row = tok->row; op->col = tok->col;
+      }
       if (op->type->init) { op->type->init(op, tok); }
       bin->init_offs++;
     }
@@ -114,11 +220,14 @@ void cx_init_ops(struct cx_bin *bin) {
 bool cx_eval(struct cx_bin *bin, size_t start_pc, ssize_t stop_pc, struct cx *cx) {
   struct cx_bin *prev_bin = cx->bin;
   size_t prev_pc = cx->pc;
+  ssize_t prev_stop_pc = cx->stop_pc;
   cx->bin = bin;
   cx->pc = start_pc;
+  cx->stop_pc = stop_pc;
   bool ok = cx_test(bin->eval)(cx, stop_pc);
   cx->bin = prev_bin;
   cx->pc = prev_pc;
+  cx->stop_pc = prev_stop_pc;
   return ok;
 }
 
@@ -152,13 +261,15 @@ static const void *get_func_id(const void *v) {
   return &(*f)->id;
 }
 
-bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
-  cx_init_ops(bin);
-
-  fputs("bool eval(struct cx *cx) {\n"
-	"bool _eval(struct cx *cx, ssize_t stop_pc) {\n"
-        "  static bool init = true;\n\n",
-	out);
+static bool emit(struct cx_bin *bin,
+		 const char *id,
+		 bool init_ops,
+		 FILE *out,
+		 struct cx *cx) {
+  fprintf(out,
+	  "bool %s(struct cx *cx, ssize_t stop_pc) {\n"
+	  "  static bool init = true;\n\n",
+	  id);
   
   struct cx_set libs, types, funcs, fimps, syms;
   cx_set_init(&libs, sizeof(struct cx_lib *), cx_cmp_ptr);
@@ -178,6 +289,13 @@ bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
     if (op->type->emit_funcs) { op->type->emit_funcs(op, &funcs, cx); }
     if (op->type->emit_fimps) { op->type->emit_fimps(op, &fimps, cx); }
     if (op->type->emit_syms) { op->type->emit_syms(op, &syms, cx); }
+
+    struct cx_fimp *imp = bin->infer[op->pc].imp;
+
+    if (imp) {
+      struct cx_fimp **ok = cx_set_insert(&fimps, &imp);
+      if (ok) { *ok = imp; }
+    }
   }
 
   cx_do_set(&types, struct cx_type *, t) {
@@ -215,20 +333,28 @@ bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
     fprintf(out,
 	    "  struct cx_type *%s() {\n"
 	    "    static struct cx_type *t = NULL;\n"
-	    "    if (!t) { t = cx_test(cx_get_type(cx, \"%s\", false)); }\n"
+	    "    if (!t) {\n"
+	    "      cx_push_lib(cx, %s());\n"
+	    "      t = cx_test(cx_get_type(cx, \"%s\", false));\n"
+	    "      cx_pop_lib(cx);\n"
+	    "    }\n\n"
 	    "    return t;\n"
 	    "  }\n\n",
-	    (*t)->emit_id, (*t)->id);
+	    (*t)->emit_id, (*t)->lib->emit_id, (*t)->id);
   }
 
   cx_do_set(&funcs, struct cx_func *, f) {
     fprintf(out,
 	    "  struct cx_func *%s() {\n"
 	    "    static struct cx_func *f = NULL;\n"
-	    "    if (!f) { f = cx_test(cx_get_func(cx, \"%s\", false)); }\n"
+	    "    if (!f) {\n"
+	    "      cx_push_lib(cx, %s());\n"
+	    "      f = cx_test(cx_get_func(cx, \"%s\", false));\n"
+	    "      cx_pop_lib(cx);\n"
+	    "    }\n\n"
 	    "    return f;\n"
 	    "  }\n\n",
-	    (*f)->emit_id, (*f)->id);
+	    (*f)->emit_id, (*f)->lib->emit_id, (*f)->id);
   }
 
   cx_do_set(&fimps, struct cx_fimp *, f) {
@@ -246,13 +372,15 @@ bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
 	"    init = false;\n",
 	out);
 
-  cx_do_vec(&cx->inits, struct cx_str *, i) {
-    fprintf(out,
-	    "if (!cx_init_%s(cx)) { goto exit; }\n",
-	    (*i)->data);
-  }
+  if (init_ops) {
+    cx_do_vec(&cx->inits, struct cx_str *, i) {
+      fprintf(out,
+	      "if (!cx_init_%s(cx)) { goto exit; }\n",
+	      (*i)->data);
+    }
   
-  fputc('\n', out);
+    fputc('\n', out);
+  }
 
   cx_do_set(&syms, struct cx_sym, s) {
     fprintf(out, "    %s = cx_sym(cx, \"%s\");\n", s->emit_id, s->id);
@@ -260,10 +388,12 @@ bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
 
   fputc('\n', out);
   
-  for (struct cx_op *op = cx_vec_start(&bin->ops);
-       op != cx_vec_end(&bin->ops);
-       op++) {
-    if (op->type->emit_init) { op->type->emit_init(op, bin, out, cx); }
+  if (init_ops) {
+    for (struct cx_op *op = cx_vec_start(&bin->ops);
+	 op != cx_vec_end(&bin->ops);
+	 op++) {
+      if (op->type->emit_init) { op->type->emit_init(op, bin, out, cx); }
+    }
   }
 
   cx_set_deinit(&libs);
@@ -284,57 +414,119 @@ bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
 	"  goto *op_labels[cx->pc];\n\n",
 	out);
   
+  size_t
+    nops = bin->ops.count,
+    *ts = cx_find_targets(cx, bin, 0),
+    *skip_pcs = malloc((nops+1)*sizeof(size_t));
+
+  skip_pcs[nops] = nops;
+  
+  for (ssize_t pc = nops-1; pc >= 0; pc--) {
+    struct cx_op *op = cx_vec_get(&bin->ops, pc+1);
+    
+    skip_pcs[pc] = (pc+1 == nops || ts[pc+1] || op->type->error_emit)
+      ? pc+1
+      : skip_pcs[pc+1];
+  }
+
+  bool ok = true, check = true;
+  
   for (struct cx_op *op = cx_vec_start(&bin->ops);
-       op != cx_vec_end(&bin->ops);
+       op != cx_vec_end(&bin->ops) && ok;
        op++) {
+    struct cx_op_type *t = op->type;
     cx->row = op->row; cx->col = op->col;
     struct cx_tok *tok = cx_vec_get(&bin->toks, op->tok_idx);
-    fprintf(out, "op%zd: { /* %s %s */\n", op->pc, tok->type->id, op->type->id);
-
-    fprintf(out,
-	    "cx->pc = %zd;\n"
-  	    "if (stop_pc == %zd) { goto exit; }\n"
-	    "cx->row = %d; cx->col = %d;\n",
-	    op->pc, op->pc, cx->row, cx->col);
-
-    if (op->type->emit && op->type->emit == op->type->error_emit) {
-      if (!op->type->emit(op, bin, out, cx)) { return false; }      
-    } else if (op->type->error_emit) {
-      fputs("if (cx->errors.count) {\n", out);
-      if (!op->type->error_emit(op, bin, out, cx)) { return false; }
-      fputc('}', out);
+    fprintf(out, "op%zd: { /* %s %s */\n", op->pc, tok->type->id, t->id);
 
-      if (op->type->emit) { 
-	fputs(" else {\n", out);
+    if (!op->pc || ts[op->pc]) {
+      fprintf(out,
+	      "if (stop_pc == %zd) { cx->pc = %zd; goto exit; }\n",
+	      op->pc, op->pc);
+      
+      check = true;
+    }
+    
+    if (t->can_fail) {
+      fprintf(out, "cx->pc = %zd;\n", op->pc);
+      
+      if (op->file) {
+	fprintf(out, "cx->file = \"%s\";\n", op->file);
       } else {
-	fputc('\n', out);
+	fputs("cx->file = NULL;\n", out);
       }
-    } else if (op->type->emit) {
-      fputs("if (!cx->errors.count) {\n", out);
+      
+      fprintf(out, "cx->row = %d; cx->col = %d;\n", cx->row, cx->col);
     }
-
-    if (op->type->emit && op->type->emit != op->type->error_emit) {
-      if (!op->type->emit(op, bin, out, cx)) { return false; }
+    
+    if (t->emit && t->emit == t->error_emit) {
+      ok = t->emit(op, bin, out, cx);
+    } else if (t->error_emit) {
+      fputs("if (cx->errors.count) {\n", out);
+      ok = t->error_emit(op, bin, out, cx);
       fputs("}\n", out);
-    } 
+
+      if (ok && t->emit) { 
+	fputs("else {\n", out);
+	ok = t->emit(op, bin, out, cx);
+	fputs("}\n", out);
+      }
+    } else if (t->emit) {
+      if (check) {
+	fprintf(out,
+		"if (cx->errors.count) { goto op%zd; }\n",
+		skip_pcs[op->pc]);
+      }
+      
+      ok = t->emit(op, bin, out, cx);
+    }
     
     fputs("}\n\n", out);
+    check = t->can_fail || t->error_emit;
   }
 
+  free(ts);
+  free(skip_pcs);
+  if (!ok) { return false; }
   fprintf(out, " op%zd:\n", bin->ops.count);
 
   fputs("exit:\n"
 	"  return !cx->errors.count;\n"
-	"}\n\n"
-	
-	"  struct cx_bin *bin = cx_bin_new();\n"
+	"}\n\n",
+	out);
+  
+  return true;
+}
+
+bool cx_emit_eval(struct cx_bin *bin,
+		  const char *id,
+		  bool init_ops,
+		  FILE *out,
+		  struct cx *cx) {
+  // Generated names restart for each function, identical code emits identical
+  // source which keeps cache keys stable.
+  
+  cx->next_gsym_tag = 0;
+  cx_init_ops(bin);
+  bin->infer = cx_infer(cx, bin);
+  bool ok = emit(bin, id, init_ops, out, cx);
+  free(bin->infer);
+  bin->infer = NULL;
+  return ok;
+}
+
+bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx) {
+  fputs("bool eval(struct cx *cx) {\n", out);
+  if (!cx_emit_eval(bin, "_eval", true, out, cx)) { return false; }
+  
+  fputs("  struct cx_bin *bin = cx_bin_new();\n"
 	"  bin->eval = _eval;\n"
 	"  bool ok = cx_eval(bin, 0, -1, cx);\n"
 	"  cx_bin_deref(bin);\n"
 	"  return ok;\n"
 	"}\n",
 	out);
-  
+
   return true;
 }
 
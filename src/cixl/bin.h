@@ -7,6 +7,7 @@
 
 struct cx;
 struct cx_fimp;
+struct cx_infer;
 struct cx_lib;
 struct cx_tok;
 
@@ -15,13 +16,21 @@ struct cx_bin_fimp {
   ssize_t start_pc, nops;
 };
 
+struct cx_bin_code {
+  void *label;
+  struct cx_op *op;
+};
+
+typedef bool (*cx_bin_eval_t)(struct cx *, ssize_t stop_pc);
+
 struct cx_bin {
-  struct cx_vec toks, ops;
+  struct cx_vec toks, ops, code;
   struct cx_set fimps;
+  struct cx_infer *infer;
   
   size_t init_offs;
   unsigned int nrefs;
-  bool (*eval)(struct cx *, ssize_t stop_pc);
+  cx_bin_eval_t eval;
 };
 
 struct cx_bin *cx_bin_new();
@@ -35,6 +44,9 @@ void cx_bin_deref(struct cx_bin *bin);
 
 void cx_init_ops(struct cx_bin *bin);
 
+bool cx_loop_eval(struct cx *cx, ssize_t stop_pc);
+bool cx_thread_eval(struct cx *cx, ssize_t stop_pc);
+
 bool cx_compile(struct cx *cx,
 		struct cx_tok *start,
 		struct cx_tok *end,
@@ -43,6 +55,13 @@ bool cx_compile(struct cx *cx,
 bool cx_eval(struct cx_bin *bin, size_t start_pc, ssize_t stop_pc, struct cx *cx);
 bool cx_eval_toks(struct cx *cx, struct cx_vec *in);
 bool cx_eval_str(struct cx *cx, const char *in);
+
+bool cx_emit_eval(struct cx_bin *bin,
+		  const char *id,
+		  bool init_ops,
+		  FILE *out,
+		  struct cx *cx);
+
 bool cx_emit(struct cx_bin *bin, FILE *out, struct cx *cx);
 
 struct cx_type *cx_init_bin_type(struct cx_lib *lib);
@@ -1,10 +1,13 @@
 #include "cixl/box.h"
 #include "cixl/cx.h"
 #include "cixl/error.h"
+#include "cixl/lib.h"
 #include "cixl/scope.h"
+#include "cixl/stats.h"
 #include "cixl/type.h"
 
 struct cx_box *cx_box_new(struct cx_type *type) {
+  cx_stat(type->lib->cx->nboxes++);
   return cx_box_init(malloc(sizeof(struct cx_box)), type);
 }
 
@@ -42,7 +42,7 @@ struct cx_box {
     struct cx_iter  *as_iter;
     struct cx_lib   *as_lib;
     struct cx_pair  *as_pair;
-    struct cx_point  as_point;
+    struct cx_point *as_point;
     struct cx_proc  *as_proc;
     struct cx_poll  *as_poll;
     void            *as_ptr;
@@ -50,9 +50,9 @@ struct cx_box {
     struct cx_ref   *as_ref;
     struct cx_sched *as_sched;
     struct cx_str   *as_str;
-    struct cx_sym    as_sym;
+    struct cx_sym   *as_sym;
     struct cx_table *as_table;
-    struct cx_time   as_time;
+    struct cx_time  *as_time;
   };
 };
 
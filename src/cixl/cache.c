@@ -0,0 +1,300 @@
+#include <dlfcn.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "cixl/cache.h"
+#include "cixl/cx.h"
+#include "cixl/emit.h"
+#include "cixl/error.h"
+#include "cixl/link.h"
+#include "cixl/mfile.h"
+#include "cixl/stats.h"
+
+#ifndef CX_SRC_DIR
+#define CX_SRC_DIR "src"
+#endif
+
+#ifndef CX_INCLUDE_DIR
+#define CX_INCLUDE_DIR "/usr/local/include"
+#endif
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static uint64_t hash_str(uint64_t h, const char *s) {
+  for (; *s; s++) { h = (h ^ (uint8_t)*s) * FNV_PRIME; }
+  return (h ^ 0xff) * FNV_PRIME;
+}
+
+#ifndef CX_ABI
+#define CX_ABI ""
+#endif
+
+// Compiled objects depend on the headers they were built against, CX_ABI is a
+// hash of their contents.
+
+static uint64_t seed() {
+  return hash_str(FNV_OFFSET, CX_VERSION " " CX_ABI);
+}
+
+static bool hash_file(const char *path, uint64_t *h) {
+  FILE *f = fopen(path, "r");
+  if (!f) { return false; }
+  uint8_t buf[4096];
+  size_t n;
+  
+  while ((n = fread(buf, 1, sizeof(buf), f))) {
+    for (uint8_t *c = buf; c < buf+n; c++) { *h = (*h ^ *c) * FNV_PRIME; }
+  }
+
+  fclose(f);
+  return true;
+}
+
+static bool get_key(const char *path, char *real_path, uint64_t *key) {
+  if (!realpath(path, real_path)) { return false; }
+  *key = hash_str(seed(), real_path);
+  return hash_file(real_path, key);
+}
+
+static bool check_deps(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) { return false; }
+  bool ok = true;
+  char line[PATH_MAX+32], *sep;
+  
+  while (ok && fgets(line, sizeof(line), f)) {
+    line[strcspn(line, "\n")] = 0;
+    uint64_t prev = strtoull(line, &sep, 16), h = FNV_OFFSET;
+    ok = *sep == ' ' && hash_file(sep+1, &h) && h == prev;
+  }
+
+  fclose(f);
+  return ok;
+}
+
+static char *key_path(const char *dir, uint64_t key, const char *ext) {
+  return cx_fmt("%s/%016" PRIx64 ".%s", dir, key, ext);
+}
+
+static bool has_marker(const char *dir, uint64_t key, const char *ext) {
+  char *path = key_path(dir, key, ext);
+  bool found = access(path, F_OK) == 0;
+  free(path);
+  return found;
+}
+
+static void set_marker(const char *dir, uint64_t key, const char *ext) {
+  char *path = key_path(dir, key, ext);
+  FILE *f = fopen(path, "w");
+  if (f) { fclose(f); }
+  free(path);
+}
+
+cx_cache_eval_t cx_cache_load(struct cx *cx, const char *dir, const char *path) {
+  char real_path[PATH_MAX];
+  uint64_t key;
+  if (!get_key(path, real_path, &key)) { return NULL; }
+
+  char *deps_path = key_path(dir, key, "deps");
+  bool ok = check_deps(deps_path);
+  free(deps_path);
+  if (!ok) { return NULL; }
+  
+  char *so_path = key_path(dir, key, "so");
+  void *h = dlopen(so_path, RTLD_NOW | RTLD_LOCAL);
+  free(so_path);
+  if (!h) { return NULL; }
+
+  // The handle stays open for the rest of the process, fimps and lambdas
+  // created by the cached code point into it.
+  
+  cx_cache_eval_t eval = (cx_cache_eval_t)dlsym(h, "eval");
+  if (!eval) { dlclose(h); }
+  return eval;
+}
+
+static bool compile(struct cx *cx, const char *src, const char *out_path) {
+  struct cx_mfile cmd;
+  cx_mfile_open(&cmd);
+  
+  fprintf(cmd.stream,
+	  "gcc -x c -std=gnu1x -O2 -shared -fPIC -w "
+	  cx_stat("-DCX_STATS ")
+	  "-I%s -I%s - -o %s",
+	  CX_SRC_DIR, CX_INCLUDE_DIR, out_path);
+  
+  cx_do_vec(&cx->links, struct cx_link, l) {
+    fprintf(cmd.stream, " -l%s", l->id+3);
+  }
+
+  cx_mfile_close(&cmd);
+  FILE *out = popen(cmd.data, "w");
+  
+  if (!out) {
+    cx_error(cx, cx->row, cx->col,
+	     "Failed executing compiler: %d\n%s", errno, cmd.data);
+    free(cmd.data);
+    return false;
+  }
+
+  free(cmd.data);
+  fputs(src, out);
+  int status = pclose(out);
+
+  if (status) {
+    cx_error(cx, cx->row, cx->col, "Failed compiling cache: %d", status);
+    return false;
+  }
+
+  return true;
+}
+
+static bool emit_module(struct cx *cx,
+			struct cx_bin *bin,
+			const char *out_path) {
+  struct cx_mfile src;
+  cx_mfile_open(&src);
+  bool ok = cx_emit_module(cx, bin, src.stream);
+  cx_mfile_close(&src);
+  if (ok) { ok = compile(cx, src.data, out_path); }
+  free(src.data);
+  return ok;
+}
+
+static bool make_dir(struct cx *cx, const char *dir) {
+  if (mkdir(dir, 0755) && errno != EEXIST) {
+    cx_error(cx, cx->row, cx->col,
+	     "Failed creating cache dir '%s': %d", dir, errno);
+    return false;
+  }
+
+  return true;
+}
+
+bool cx_cache_store(struct cx *cx,
+		    const char *dir,
+		    const char *path,
+		    struct cx_bin *bin,
+		    size_t nfiles) {
+  char real_path[PATH_MAX];
+  uint64_t key;
+
+  if (!get_key(path, real_path, &key)) {
+    cx_error(cx, cx->row, cx->col, "Failed reading file '%s': %d", path, errno);
+    return false;
+  }
+
+  if (!make_dir(cx, dir)) { return false; }
+
+  // Failed compiles are recorded so following runs skip the compiler, removing
+  // the marker or changing the source retries. Scripts are only compiled the
+  // second time they are seen, which keeps one off runs from paying for it.
+  
+  if (has_marker(dir, key, "fail")) { return true; }
+  
+  if (!has_marker(dir, key, "seen")) {
+    set_marker(dir, key, "seen");
+    return true;
+  }
+  
+  bool ok = false;
+  char
+    *so_path = key_path(dir, key, "so"),
+    *deps_path = key_path(dir, key, "deps"),
+    *tmp_path = cx_fmt("%s/%016" PRIx64 ".%d.tmp", dir, key, getpid());
+
+  if (!emit_module(cx, bin, tmp_path)) {
+    set_marker(dir, key, "fail");
+    goto exit;
+  }
+
+  if (rename(tmp_path, so_path)) {
+    cx_error(cx, cx->row, cx->col, "Failed renaming '%s': %d", tmp_path, errno);
+    goto exit;
+  }
+  
+  FILE *deps = fopen(tmp_path, "w");
+
+  if (!deps) {
+    cx_error(cx, cx->row, cx->col, "Failed opening '%s': %d", tmp_path, errno);
+    goto exit;
+  }
+
+  // Files loaded after the script itself are include: dependencies.
+  
+  for (char **f = cx_vec_get(&cx->load_files, nfiles+1);
+       f < (char **)cx_vec_end(&cx->load_files);
+       f++) {
+    char dep[PATH_MAX];
+    uint64_t h = FNV_OFFSET;
+    
+    if (realpath(*f, dep) && hash_file(dep, &h)) {
+      fprintf(deps, "%016" PRIx64 " %s\n", h, dep);
+    }
+  }
+  
+  fclose(deps);
+
+  if (rename(tmp_path, deps_path)) {
+    cx_error(cx, cx->row, cx->col, "Failed renaming '%s': %d", tmp_path, errno);
+    goto exit;
+  }
+  
+  ok = true;
+ exit:
+  unlink(tmp_path);
+  free(so_path);
+  free(deps_path);
+  free(tmp_path);
+  return ok;
+}
+
+cx_bin_eval_t cx_cache_compile(struct cx *cx,
+			       const char *dir,
+			       const char *src,
+			       const char *id) {
+  uint64_t key = hash_str(seed(), src);
+  
+  char *so_path = key_path(dir, key, "so");
+  void *h = dlopen(so_path, RTLD_NOW | RTLD_LOCAL);
+  
+  if (!h) {
+    if (has_marker(dir, key, "fail")) {
+      free(so_path);
+      return NULL;
+    }
+    
+    char *tmp_path = cx_fmt("%s/%016" PRIx64 ".%d.tmp", dir, key, getpid());
+    bool ok = make_dir(cx, dir) && compile(cx, src, tmp_path);
+    if (!ok) { set_marker(dir, key, "fail"); }
+
+    if (ok && rename(tmp_path, so_path)) {
+      cx_error(cx, cx->row, cx->col, "Failed renaming '%s': %d", tmp_path, errno);
+      ok = false;
+    }
+
+    unlink(tmp_path);
+    free(tmp_path);
+    
+    if (ok && !(h = dlopen(so_path, RTLD_NOW | RTLD_LOCAL))) {
+      cx_error(cx, cx->row, cx->col, "Failed loading '%s': %s", so_path, dlerror());
+    }
+  }
+
+  free(so_path);
+  if (!h) { return NULL; }
+  cx_bin_eval_t eval = (cx_bin_eval_t)dlsym(h, id);
+
+  if (!eval) {
+    cx_error(cx, cx->row, cx->col, "Missing symbol '%s': %s", id, dlerror());
+    dlclose(h);
+  }
+  
+  return eval;
+}
@@ -0,0 +1,26 @@
+#ifndef CX_CACHE_H
+#define CX_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "cixl/bin.h"
+
+struct cx;
+
+typedef bool (*cx_cache_eval_t)(struct cx *);
+
+cx_cache_eval_t cx_cache_load(struct cx *cx, const char *dir, const char *path);
+
+bool cx_cache_store(struct cx *cx,
+		    const char *dir,
+		    const char *path,
+		    struct cx_bin *bin,
+		    size_t nfiles);
+
+cx_bin_eval_t cx_cache_compile(struct cx *cx,
+			       const char *dir,
+			       const char *src,
+			       const char *id);
+
+#endif
@@ -7,6 +7,7 @@
 #include "cixl/fimp.h"
 #include "cixl/func.h"
 #include "cixl/scope.h"
+#include "cixl/stats.h"
 
 struct cx_call *cx_call_init(struct cx_call *c,
 			     int row, int col,
@@ -17,6 +18,8 @@ struct cx_call *cx_call_init(struct cx_call *c,
   c->fimp = fimp;
   c->scope = cx_scope_ref(scope);
   c->recalls = 0;
+  c->return_pc = -1;
+  cx_stat(cx_timer_reset(&c->timer));
   return c;
 }
 
@@ -69,6 +72,8 @@ struct cx_call *cx_call_copy(struct cx_call *dst, struct cx_call *src) {
   dst->fimp = src->fimp;
   dst->scope = cx_scope_ref(src->scope);
   dst->recalls = src->recalls;
+  dst->return_pc = src->return_pc;
+  cx_stat(dst->timer = src->timer);
   struct cx_box *dv = dst->args, *sv = src->args;
   
   for (unsigned int i=0; i < src->fimp->args.count; i++, dv++, sv++) {
@@ -77,3 +82,10 @@ struct cx_call *cx_call_copy(struct cx_call *dst, struct cx_call *src) {
 
   return dst;
 }
+
+#ifdef CX_STATS
+void cx_call_stat(struct cx_call *c) {
+  c->fimp->stat_calls++;
+  c->fimp->stat_ns += cx_timer_ns(&c->timer);
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include "cixl/arg.h"
 #include "cixl/box.h"
+#include "cixl/timer.h"
 
 struct cx_call {
   int row, col;
@@ -10,6 +11,11 @@ struct cx_call {
   struct cx_scope *scope;
   struct cx_box args[CX_MAX_ARGS];
   int recalls;
+  ssize_t return_pc;
+
+#ifdef CX_STATS
+  cx_timer_t timer;
+#endif
 };
 
 struct cx_call *cx_call_init(struct cx_call *c,
@@ -23,4 +29,8 @@ bool cx_call_pop_args(struct cx_call *c);
 void cx_call_deinit_args(struct cx_call *c);
 struct cx_call *cx_call_copy(struct cx_call *dst, struct cx_call *src);
 
+#ifdef CX_STATS
+void cx_call_stat(struct cx_call *c);
+#endif
+
 #endif
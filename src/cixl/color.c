@@ -12,8 +12,7 @@
 #include "cixl/util.h"
 
 struct cx_color *cx_color_init(struct cx_color *c,
-			       unsigned int r, unsigned int g, unsigned int b,
-			       unsigned int a) {
+			       uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
   c->r = r;
   c->g = g;
   c->b = b;
@@ -29,11 +28,11 @@ static bool equid_imp(struct cx_box *x, struct cx_box *y) {
 static enum cx_cmp cmp_imp(const struct cx_box *x, const struct cx_box *y) {
   const struct cx_color *xv = &x->as_color, *yv = &y->as_color;
   
-  enum cx_cmp cmp = cx_cmp_cint(&xv->r, &yv->r);
-  if (cmp != CX_CMP_EQ) { return cmp; }
-  cmp = cx_cmp_cint(&xv->g, &yv->g);
-  if (cmp != CX_CMP_EQ) { return cmp; }
-  return cx_cmp_cint(&xv->b, &yv->b);
+  int d = xv->r - yv->r;
+  if (!d) { d = xv->g - yv->g; }
+  if (!d) { d = xv->b - yv->b; }
+  if (d < 0) { return CX_CMP_LT; }
+  return d ? CX_CMP_GT : CX_CMP_EQ;
 }
 
 static bool ok_imp(struct cx_box *v) {
@@ -43,12 +42,12 @@ static bool ok_imp(struct cx_box *v) {
 
 static void dump_imp(struct cx_box *v, FILE *out) {
   struct cx_color *vv = &v->as_color;
-  fprintf(out, "Color(%u %u %u %u)", vv->r, vv->g, vv->b, vv->a);
+  fprintf(out, "Color(%d %d %d %d)", vv->r, vv->g, vv->b, vv->a);
 }
 
 static void write_imp(struct cx_box *v, FILE *out) {
   struct cx_color *vv = &v->as_color;
-  fprintf(out, "(%u %u %u %u new-color)", vv->r, vv->g, vv->b, vv->a);
+  fprintf(out, "(%d %d %d %d new-color)", vv->r, vv->g, vv->b, vv->a);
 }
 
 static bool emit_imp(struct cx_box *v, const char *exp, FILE *out) {
@@ -56,7 +55,7 @@ static bool emit_imp(struct cx_box *v, const char *exp, FILE *out) {
 
   fprintf(out,
 	  "cx_color_init(&cx_box_init(%s, cx->color_type)->as_color, "
-	  "%u, %u, %u, %u);\n",
+	  "%d, %d, %d, %d);\n",
 	  exp, vv->r, vv->g, vv->b, vv->a);
   
   return true;
@@ -12,6 +12,7 @@ struct cx_cont *cx_cont_init(struct cx_cont *c, struct cx *cx) {
   c->prev_task = NULL;
   c->prev_bin = c->bin = NULL;
   c->prev_pc = c->pc = -1;
+  c->prev_stop_pc = c->stop_pc = -1;
   c->prev_nlibs = c->prev_nscopes = c->prev_ncalls = -1;
   cx_vec_init(&c->libs, sizeof(struct cx_lib *));
   cx_vec_init(&c->scopes, sizeof(struct cx_scope *));
@@ -40,6 +41,7 @@ void cx_cont_reset(struct cx_cont *c) {
   c->prev_task = cx->task;
   c->prev_bin = cx->bin;
   c->prev_pc = cx->pc;
+  c->prev_stop_pc = cx->stop_pc;
   c->prev_nlibs = cx->libs.count;
   c->prev_nscopes = cx->scopes.count;
   c->prev_ncalls = cx->ncalls;
@@ -53,6 +55,8 @@ void cx_cont_suspend(struct cx_cont *c) {
   cx->bin = c->prev_bin;
   c->pc = cx->pc;
   cx->pc = c->prev_pc;
+  c->stop_pc = cx->stop_pc;
+  cx->stop_pc = c->prev_stop_pc;
 
   ssize_t nlibs = cx->libs.count - c->prev_nlibs;
   
@@ -97,6 +101,7 @@ void cx_cont_resume(struct cx_cont *c) {
   cx_cont_reset(c);
   cx->bin = c->bin;
   cx->pc = c->pc;
+  cx->stop_pc = c->stop_pc;
 
   if (c->libs.count) {
     cx_vec_grow(&cx->libs, cx->libs.count+c->libs.count);
@@ -138,6 +143,7 @@ void cx_cont_finish(struct cx_cont *c) {
   cx->task = c->prev_task;
   cx->bin = c->prev_bin;
   cx->pc = c->prev_pc;
+  cx->stop_pc = c->prev_stop_pc;
 
   while (cx->libs.count > c->prev_nlibs) { cx_pop_lib(cx); }
   while (cx->scopes.count > c->prev_nscopes) { cx_pop_scope(cx, false); }
@@ -1,6 +1,7 @@
 #include <dlfcn.h>
 #include <errno.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -19,6 +20,7 @@
 #include "cixl/int.h"
 #include "cixl/lambda.h"
 #include "cixl/lib/abc.h"
+#include "cixl/lib/bench.h"
 #include "cixl/lib/bin.h"
 #include "cixl/lib/buf.h"
 #include "cixl/lib/cond.h"
@@ -34,6 +36,7 @@
 #include "cixl/lib/net.h"
 #include "cixl/lib/pair.h"
 #include "cixl/lib/proc.h"
+#include "cixl/lib/prof.h"
 #include "cixl/lib/poll.h"
 #include "cixl/lib/rec.h"
 #include "cixl/lib/ref.h"
@@ -55,6 +58,7 @@
 #include "cixl/ref.h"
 #include "cixl/scope.h"
 #include "cixl/stack.h"
+#include "cixl/stats.h"
 #include "cixl/str.h"
 #include "cixl/table.h"
 #include "cixl/task.h"
@@ -70,6 +74,7 @@ cx_lib(cx_init_world, "cx") {
   
   return
     cx_use(cx, "cx/abc") &&
+    cx_use(cx, "cx/bench") &&
     cx_use(cx, "cx/bin") &&
     cx_use(cx, "cx/cond") &&
     cx_use(cx, "cx/const") &&
@@ -87,6 +92,7 @@ cx_lib(cx_init_world, "cx") {
     cx_use(cx, "cx/net") &&
     cx_use(cx, "cx/pair") &&
     cx_use(cx, "cx/proc") &&
+    cx_use(cx, "cx/prof") &&
     cx_use(cx, "cx/rec") &&
     cx_use(cx, "cx/ref") &&
     cx_use(cx, "cx/stack") &&
@@ -101,36 +107,57 @@ cx_lib(cx_init_world, "cx") {
 }
 
 struct cx *cx_init(struct cx *cx) {
-  cx->next_sym_tag = cx->next_type_tag = 0;
+  cx->next_sym_tag = cx->next_type_tag = cx->next_gsym_tag = 0;
   cx->ncalls = 0;
   cx->task = NULL;
   cx->coro = NULL;
   cx->bin = NULL;
   cx->pc = 0;
+  cx->stop_pc = -1;
+  cx->file = NULL;
   cx->row = cx->col = -1;
+  cx_peephole_init(&cx->peephole);
+  cx_prof_init(&cx->prof, cx);
+  cx->dispatch_epoch = 1;
+  cx->const_epoch = 1;
+  cx->dispatch_hits = cx->dispatch_misses = 0;
+  cx->funcall_hits = cx->funcall_misses = 0;
+  cx->tier_calls = 0;
+  cx->tier_dir = NULL;
+  cx_stat(cx->nscopes = cx->nboxes = cx->npushes = 0);
+  cx->compile_depth = 0;
   
   cx_malloc_init(&cx->box_alloc, CX_SLAB_SIZE, sizeof(struct cx_box));
   cx_malloc_init(&cx->buf_alloc, CX_SLAB_SIZE, sizeof(struct cx_buf));
   cx_malloc_init(&cx->file_alloc, CX_SLAB_SIZE, sizeof(struct cx_file));
   cx_malloc_init(&cx->lambda_alloc, CX_SLAB_SIZE, sizeof(struct cx_lambda));
   cx_malloc_init(&cx->pair_alloc, CX_SLAB_SIZE, sizeof(struct cx_pair));
+  cx_malloc_init(&cx->point_alloc, CX_SLAB_SIZE, sizeof(struct cx_point));
   cx_malloc_init(&cx->rec_alloc, CX_SLAB_SIZE, sizeof(struct cx_rec));
   cx_malloc_init(&cx->ref_alloc, CX_SLAB_SIZE, sizeof(struct cx_ref));
   cx_malloc_init(&cx->scope_alloc, CX_SLAB_SIZE, sizeof(struct cx_scope));
   cx_malloc_init(&cx->table_alloc, CX_SLAB_SIZE, sizeof(struct cx_table));
   cx_malloc_init(&cx->task_alloc, CX_SLAB_SIZE, sizeof(struct cx_task));
+  cx_malloc_init(&cx->time_alloc, CX_SLAB_SIZE, sizeof(struct cx_time));
   cx_malloc_init(&cx->var_alloc, CX_SLAB_SIZE, sizeof(struct cx_var));
   cx_malloc_init(&cx->stack_alloc, CX_SLAB_SIZE, sizeof(struct cx_stack));
   
+  cx_malloc_init(&cx->str_alloc,
+		 CX_SLAB_SIZE,
+		 sizeof(struct cx_str)+CX_STR_SHORT+1);
+  
   cx_malloc_init(&cx->stack_items_alloc,
 		 CX_SLAB_SIZE,
 		 sizeof(struct cx_box)*CX_VEC_MIN);
 
+  cx_malloc_init(&cx->slot_items_alloc,
+		 CX_SLAB_SIZE,
+		 sizeof(struct cx_var)*CX_VEC_MIN);
+
   cx_set_init(&cx->separators, sizeof(char), cx_cmp_char);
   cx_add_separators(cx, " \t\n;,|?!()[]{}");
 
-  cx_set_init(&cx->syms, sizeof(struct cx_sym), cx_cmp_cstr);
-  cx->syms.key_offs = offsetof(struct cx_sym, id);
+  cx_sym_table_init(&cx->syms);
 
   cx_vec_init(&cx->types, sizeof(struct cx_type *));
   cx_vec_init(&cx->rmacros, sizeof(struct cx_rmacro *));
@@ -143,10 +170,12 @@ struct cx *cx_init(struct cx *cx) {
   cx->lib_lookup.key = get_lib_id;
   cx_vec_init(&cx->libs, sizeof(struct cx_lib *));
 
+  cx->lib_init_ns = 0;
   cx->lobby = cx_add_lib(cx, "lobby");
   cx_push_lib(cx, cx->lobby);
   
   cx_vec_init(&cx->load_paths, sizeof(char *));
+  cx_vec_init(&cx->load_files, sizeof(char *));
   cx_vec_init(&cx->scopes, sizeof(struct cx_scope *));
   cx_vec_init(&cx->errors, sizeof(struct cx_error *));
 
@@ -175,6 +204,7 @@ struct cx *cx_init(struct cx *cx) {
 
 void cx_init_libs(struct cx *cx) {
   cx_init_abc(cx);
+  cx_init_bench(cx);
   cx_init_bin(cx);
   cx_init_buf(cx);
   cx_init_cond(cx);
@@ -191,6 +221,7 @@ void cx_init_libs(struct cx *cx) {
   cx_init_pair(cx);
   cx_init_poll(cx);
   cx_init_proc(cx);
+  cx_init_prof(cx);
   cx_init_rec(cx);
   cx_init_ref(cx);
   cx_init_stack(cx);
@@ -208,6 +239,8 @@ void cx_init_libs(struct cx *cx) {
 
 struct cx *cx_deinit(struct cx *cx) {
   cx_set_deinit(&cx->separators);
+  if (cx->tier_dir) { free(cx->tier_dir); }
+  cx_prof_deinit(&cx->prof);
 
   cx_do_vec(&cx->errors, struct cx_error *, e) { cx_error_deref(*e); }
   cx_vec_deinit(&cx->errors);
@@ -217,7 +250,7 @@ struct cx *cx_deinit(struct cx *cx) {
   }
   
   cx_do_vec(&cx->scopes, struct cx_scope *, s) {
-    cx_env_clear(&(*s)->vars);
+    cx_clear_vars(*s);
     cx_scope_deref(*s);
   }
   
@@ -225,6 +258,9 @@ struct cx *cx_deinit(struct cx *cx) {
 
   cx_do_vec(&cx->load_paths, char *, p) { free(*p); }
   cx_vec_deinit(&cx->load_paths);
+
+  cx_do_vec(&cx->load_files, char *, p) { free(*p); }
+  cx_vec_deinit(&cx->load_files);
   
   cx_do_vec(&cx->rmacros, struct cx_rmacro *, m) { free(cx_rmacro_deinit(*m)); }
   cx_vec_deinit(&cx->rmacros);
@@ -248,22 +284,25 @@ struct cx *cx_deinit(struct cx *cx) {
   cx_do_vec(&cx->types, struct cx_type *, t) { free(cx_type_deinit(*t)); }
   cx_vec_deinit(&cx->types);
 
-  cx_do_set(&cx->syms, struct cx_sym, s) { cx_sym_deinit(s); }
-  cx_set_deinit(&cx->syms);
+  cx_sym_table_deinit(&cx->syms);
   
   cx_malloc_deinit(&cx->box_alloc);
   cx_malloc_deinit(&cx->buf_alloc);
   cx_malloc_deinit(&cx->file_alloc);
   cx_malloc_deinit(&cx->lambda_alloc);
   cx_malloc_deinit(&cx->pair_alloc);
+  cx_malloc_deinit(&cx->point_alloc);
   cx_malloc_deinit(&cx->rec_alloc);
   cx_malloc_deinit(&cx->ref_alloc);
   cx_malloc_deinit(&cx->scope_alloc);
   cx_malloc_deinit(&cx->table_alloc);
   cx_malloc_deinit(&cx->task_alloc);
+  cx_malloc_deinit(&cx->time_alloc);
   cx_malloc_deinit(&cx->var_alloc);
   cx_malloc_deinit(&cx->stack_alloc);
   cx_malloc_deinit(&cx->stack_items_alloc);
+  cx_malloc_deinit(&cx->slot_items_alloc);
+  cx_malloc_deinit(&cx->str_alloc);
 
   return cx;
 }
@@ -316,12 +355,16 @@ struct cx_lib *cx_pop_lib(struct cx *cx) {
 }
 
 struct cx_sym cx_sym(struct cx *cx, const char *id) {
-  struct cx_sym *s = cx_set_get(&cx->syms, &id);
-  return s ? *s : *cx_sym_init(cx_set_insert(&cx->syms, &id), id, cx->next_sym_tag++);
+  return *cx_intern(cx, id);
+}
+
+struct cx_sym *cx_intern(struct cx *cx, const char *id) {
+  struct cx_sym *s = cx_sym_table_get(&cx->syms, id);
+  return s->id ? s : cx_sym_init(s, id, cx->next_sym_tag++);
 }
 
 struct cx_sym cx_gsym(struct cx *cx, const char *prefix) {
-  char *id = cx_fmt("%s%zd", prefix, cx->next_sym_tag);
+  char *id = cx_fmt("%s%zd", prefix, cx->next_gsym_tag++);
   struct cx_sym s = cx_sym(cx, id);
   free(id);
   return s;
@@ -373,6 +416,73 @@ void cx_end(struct cx *cx) {
   cx_pop_scope(cx, false);
 }
 
+#define ALLOC(fld, id) {id, offsetof(struct cx, fld##_alloc)}
+
+static const struct {
+  const char *id;
+  size_t offs;
+} allocs[] = {
+  ALLOC(box, "box"), ALLOC(buf, "buf"), ALLOC(file, "file"),
+  ALLOC(lambda, "lambda"), ALLOC(pair, "pair"), ALLOC(point, "point"),
+  ALLOC(rec, "rec"), ALLOC(ref, "ref"), ALLOC(scope, "scope"), ALLOC(slot_items, "slot-items"),
+  ALLOC(stack, "stack"), ALLOC(stack_items, "stack-items"), ALLOC(str, "str"),
+  ALLOC(table, "table"), ALLOC(task, "task"), ALLOC(time, "time"),
+  ALLOC(var, "var")
+};
+
+#define NALLOCS (sizeof(allocs) / sizeof(allocs[0]))
+
+struct cx_malloc *cx_get_alloc(struct cx *cx, size_t i, const char **id) {
+  if (i >= NALLOCS) { return NULL; }
+  if (id) { *id = allocs[i].id; }
+  return (struct cx_malloc *)((char *)cx + allocs[i].offs);
+}
+
+void cx_push_arena(struct cx *cx) {
+  for (size_t i = 0; i < NALLOCS; i++) {
+    cx_malloc_push_arena(cx_get_alloc(cx, i, NULL));
+  }
+}
+
+bool cx_pop_arena(struct cx *cx) {
+  bool ok = true;
+  
+  for (size_t i = 0; i < NALLOCS; i++) {
+    if (!cx_malloc_pop_arena(cx_get_alloc(cx, i, NULL))) { ok = false; }
+  }
+
+  return ok;
+}
+
+void cx_swap_arenas(struct cx *cx, struct cx_vec *arenas) {
+  if (!arenas->count) {
+    for (size_t i = 0; i < NALLOCS; i++) {
+      *(struct cx_malloc_arena **)cx_vec_push(arenas) = NULL;
+    }
+  }
+
+  for (size_t i = 0; i < NALLOCS; i++) {
+    struct cx_malloc *a = cx_get_alloc(cx, i, NULL);
+    struct cx_malloc_arena **p = cx_vec_get(arenas, i), *prev = a->arena;
+    a->arena = *p;
+    *p = prev;
+  }
+}
+
+void cx_dump_allocs(struct cx *cx, FILE *out) {
+  fprintf(out, "%-12s %10s %10s %10s %10s %12s\n",
+	  "Pool", "Live", "Max", "Slabs", "Free", "Bytes");
+  
+  for (size_t i = 0; i < NALLOCS; i++) {
+    const char *id = NULL;
+    struct cx_malloc *a = cx_get_alloc(cx, i, &id);
+    
+    fprintf(out, "%-12s %10zd %10zd %10zd %10zd %12zd\n",
+	    id, a->nlive, a->max_live, a->nslabs, a->nslots - a->nlive,
+	    cx_malloc_bytes(a));
+  }
+}
+
 bool cx_funcall(struct cx *cx, const char *id) {
   struct cx_func *func = cx_get_func(cx, id, false);
   if (!func) { return false; }
@@ -409,6 +519,7 @@ bool cx_pop_call(struct cx *cx) {
   }
   
   cx->ncalls--;
+  cx_stat(cx_call_stat(cx->calls+cx->ncalls));
   cx_call_deinit(cx->calls+cx->ncalls);
   return true;
 }
@@ -443,6 +554,8 @@ bool cx_load_toks(struct cx *cx, const char *path, struct cx_vec *out) {
     return false;
   }
 
+  const char *prev_file = cx->file;
+  cx->file = *(char **)cx_vec_push(&cx->load_files) = strdup(path);
   int prev_row = cx->row, prev_col = cx->col;
   cx->row = 1; cx->col = 0;
   char c = fgetc(f);
@@ -463,6 +576,7 @@ bool cx_load_toks(struct cx *cx, const char *path, struct cx_vec *out) {
 
   bool ok = cx_parse(cx, f, out, true);
   fclose(f);
+  cx->file = prev_file;
   cx->row = prev_row; cx->col = prev_col;
   return ok;
 }
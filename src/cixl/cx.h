@@ -7,12 +7,14 @@
 #include "cixl/lib.h"
 #include "cixl/malloc.h"
 #include "cixl/parse.h"
+#include "cixl/peephole.h"
+#include "cixl/prof.h"
 #include "cixl/set.h"
 #include "cixl/type.h"
 
 #define CX_VERSION "0.9.8"
 #define CX_SLAB_SIZE 32				  
-#define CX_MAX_CALLS 64
+#define CX_MAX_CALLS 1024
 
 struct cx_arg;
 struct cx_catch;
@@ -28,10 +30,10 @@ struct cx {
     buf_alloc,
     file_alloc,
     lambda_alloc,
-    pair_alloc,
+    pair_alloc, point_alloc,
     rec_alloc, ref_alloc,
-    scope_alloc, stack_alloc, stack_items_alloc,
-    table_alloc, task_alloc,
+    scope_alloc, slot_items_alloc, stack_alloc, stack_items_alloc, str_alloc,
+    table_alloc, task_alloc, time_alloc,
     var_alloc;
 
   struct cx_vec types,
@@ -43,6 +45,7 @@ struct cx {
   struct cx_set lib_lookup;
   struct cx_vec libs;
   struct cx_lib *lobby, **lib;
+  int64_t lib_init_ns;
 
   struct cx_type *any_type,
     *bin_type, *bool_type, *buf_type,
@@ -60,10 +63,22 @@ struct cx {
     *table_type, *tcp_client_type, *tcp_server_type, *time_type,
     *wfile_type;
 
-  size_t next_sym_tag, next_type_tag;
-  struct cx_set syms;
+  size_t next_sym_tag, next_type_tag, next_gsym_tag;
+  struct cx_sym_table syms;
   
-  struct cx_vec load_paths;
+  struct cx_vec load_paths, load_files;
+  struct cx_peephole peephole;
+  struct cx_prof prof;
+  unsigned int compile_depth;
+  size_t dispatch_epoch, dispatch_hits, dispatch_misses;
+  size_t const_epoch;
+  size_t funcall_hits, funcall_misses;
+  size_t tier_calls;
+  char *tier_dir;
+
+#ifdef CX_STATS
+  size_t nscopes, nboxes, npushes;
+#endif
   
   struct cx_vec scopes;
   struct cx_scope *root_scope, **scope;
@@ -75,7 +90,9 @@ struct cx {
   struct cx_coro *coro;
   struct cx_bin *bin;
   size_t pc;
+  ssize_t stop_pc;
   
+  const char *file;
   int row, col;
   struct cx_vec errors;
 };
@@ -95,6 +112,7 @@ void cx_push_lib(struct cx *cx, struct cx_lib *lib);
 struct cx_lib *cx_pop_lib(struct cx *cx);
 
 struct cx_sym cx_sym(struct cx *cx, const char *id);
+struct cx_sym *cx_intern(struct cx *cx, const char *id);
 struct cx_sym cx_gsym(struct cx *cx, const char *prefix);
 
 struct cx_scope *cx_scope(struct cx *cx, size_t i);
@@ -103,6 +121,12 @@ struct cx_scope *cx_pop_scope(struct cx *cx, bool silent);
 struct cx_scope *cx_begin(struct cx *cx, struct cx_scope *parent);
 void cx_end(struct cx *cx);
 
+void cx_push_arena(struct cx *cx);
+bool cx_pop_arena(struct cx *cx);
+void cx_swap_arenas(struct cx *cx, struct cx_vec *arenas);
+struct cx_malloc *cx_get_alloc(struct cx *cx, size_t i, const char **id);
+void cx_dump_allocs(struct cx *cx, FILE *out);
+
 bool cx_funcall(struct cx *cx, const char *id);
 
 struct cx_call *cx_push_call(struct cx *cx,
@@ -87,13 +87,11 @@ void cx_push_args(struct cx *cx, int argc, char *argv[]) {
   for (int i=0; i < argc; i++) {
     const char *a = argv[i];
     cx_box_init(cx_vec_push(&args->imp), cx->str_type)->as_str =
-      cx_str_new(a, strlen(a));
+      cx_str_new(cx, a, strlen(a));
   }
 }
 
-bool cx_emit_file(struct cx *cx, struct cx_bin *bin, FILE *out) {
-  bool ok = false;
-
+void cx_emit_includes(FILE *out) {
   fputs("#include <stdlib.h>\n"
 	"#include <string.h>\n"
 	"#include <time.h>\n"
@@ -113,12 +111,21 @@ bool cx_emit_file(struct cx *cx, struct cx_bin *bin, FILE *out) {
 	"#include \"cixl/table.h\"\n"
 	"#include \"cixl/type_set.h\"\n\n",
 	out);
+}
+
+bool cx_emit_module(struct cx *cx, struct cx_bin *bin, FILE *out) {
+  cx_emit_includes(out);
 
   cx_do_vec(&cx->inits, struct cx_str *, i) {
     fprintf(out, "extern bool cx_init_%s(struct cx *cx);\n\n", (*i)->data);
   }
   
-  if (!cx_emit(bin, out, cx)) { goto exit; }
+  return cx_emit(bin, out, cx);
+}
+
+bool cx_emit_file(struct cx *cx, struct cx_bin *bin, FILE *out) {
+  bool ok = false;
+  if (!cx_emit_module(cx, bin, out)) { goto exit; }
       
   fputs("struct cx cx;\n"
 	"static void deinit_cx() { cx_deinit(&cx); }\n\n"
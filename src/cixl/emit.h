@@ -9,6 +9,8 @@ struct cx_bin;
 
 char *cx_emit_id(const char *prefix, const char *in);
 void cx_push_args(struct cx *cx, int argc, char *argv[]);
+void cx_emit_includes(FILE *out);
+bool cx_emit_module(struct cx *cx, struct cx_bin *bin, FILE *out);
 bool cx_emit_file(struct cx *cx, struct cx_bin *bin, FILE *out);
   
 #endif
@@ -41,7 +41,7 @@ struct cx_error *cx_error_init(struct cx_error *e,
     cx_vec_grow(&e->calls, n);
     struct cx_call *src = cx->calls, *dst = cx_vec_start(&e->calls);
     
-    for (unsigned int i=0; i < cx->ncalls; i++, src++, dst++) {
+    for (size_t i=0; i < n; i++, src++, dst++) {
       cx_call_copy(dst, src);
     }
     
@@ -98,7 +98,7 @@ struct cx_error *cx_error(struct cx *cx, int row, int col, const char *spec, ...
   va_end(args);
   
   struct cx_box v;
-  cx_box_init(&v, cx->str_type)->as_str = cx_str_new(msg, strlen(msg));
+  cx_box_init(&v, cx->str_type)->as_str = cx_str_new(cx, msg, strlen(msg));
   free(msg);
   
   struct cx_error *e = new_error(cx, row, col, &v);
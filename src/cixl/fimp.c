@@ -3,6 +3,7 @@
 #include "cixl/arg.h"
 #include "cixl/bin.h"
 #include "cixl/box.h"
+#include "cixl/cache.h"
 #include "cixl/call.h"
 #include "cixl/call_iter.h"
 #include "cixl/cx.h"
@@ -10,8 +11,11 @@
 #include "cixl/error.h"
 #include "cixl/fimp.h"
 #include "cixl/func.h"
+#include "cixl/mfile.h"
 #include "cixl/op.h"
 #include "cixl/scope.h"
+#include "cixl/slots.h"
+#include "cixl/stats.h"
 #include "cixl/tok.h"
 
 struct cx_fimp *cx_fimp_init(struct cx_fimp *imp,
@@ -25,7 +29,10 @@ struct cx_fimp *cx_fimp_init(struct cx_fimp *imp,
   imp->ptr = NULL;
   imp->bin = NULL;
   imp->scope = NULL;
+  imp->ncalls = 0;
   imp->init = true;
+  imp->native = imp->pure = false;
+  cx_stat(imp->stat_calls = 0; imp->stat_ns = 0);
   
   cx_vec_init(&imp->args, sizeof(struct cx_arg));
   cx_vec_init(&imp->rets, sizeof(struct cx_arg));
@@ -120,7 +127,9 @@ static bool compile(struct cx_fimp *imp, size_t tok_idx, struct cx_bin *out) {
   op->as_begin.fimp = imp;
 
   if (imp->args.count) {
-    cx_op_new(out, CX_OPUTARGS(), tok_idx)->as_putargs.imp = imp;
+    op = cx_op_new(out, CX_OPUTARGS(), tok_idx);
+    op->as_putargs.imp = imp;
+    op->as_putargs.slots = false;
   }
 
   if (imp->toks.count) {
@@ -144,6 +153,7 @@ static bool compile(struct cx_fimp *imp, size_t tok_idx, struct cx_bin *out) {
   
   op = cx_vec_get(&out->ops, start_pc);
   op->as_begin.nops = out->ops.count-start_pc-1;
+  if (!cx->compile_depth) { cx_alloc_slots(cx, out, start_pc); }
   return true;
 }
 
@@ -208,6 +218,42 @@ bool cx_fimp_call(struct cx_fimp *imp, struct cx_scope *scope) {
 		 cx);
 }
 
+void cx_fimp_native(struct cx_fimp *imp, const char *dir) {
+  struct cx *cx = imp->lib->cx;
+  cx_test(!imp->ptr && !imp->native);
+  int row = cx->row, col = cx->col;
+  size_t nerrors = cx->errors.count;
+  imp->native = true;
+  cx_bin_eval_t eval = NULL;
+  
+  if (!imp->bin) {
+    imp->bin = cx_bin_new();
+    if (!cx_fimp_inline(imp, 0, imp->bin, cx)) { goto exit; }
+  }
+
+  // Outer activations keep interpreting the same ops, only new calls enter
+  // the compiled evaluator.
+  
+  struct cx_mfile src;
+  cx_mfile_open(&src);
+  cx_emit_includes(src.stream);
+  bool ok = cx_emit_eval(imp->bin, "eval", false, src.stream, cx);
+  cx_mfile_close(&src);
+  if (ok) { eval = cx_cache_compile(cx, dir, src.data, "eval"); }
+  free(src.data);
+  if (eval) { imp->bin->eval = eval; }
+ exit:
+  // Failing to compile is not an error, the imp keeps running interpreted and
+  // isn't retried.
+  
+  while (cx->errors.count > nerrors) {
+    cx_error_deref(*(struct cx_error **)cx_vec_pop(&cx->errors));
+  }
+
+  cx->row = row;
+  cx->col = col;
+}
+
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
   return x->as_ptr == y->as_ptr;
 }
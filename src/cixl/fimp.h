@@ -1,6 +1,7 @@
 #ifndef CX_FIMP_H
 #define CX_FIMP_H
 
+#include <stdint.h>
 #include <cixl/vec.h>
 
 struct cx;
@@ -21,7 +22,13 @@ struct cx_fimp {
   struct cx_vec toks;
   struct cx_bin *bin;
   struct cx_scope *scope;
-  bool init;
+  size_t ncalls;
+  bool init, native, pure;
+
+#ifdef CX_STATS
+  size_t stat_calls;
+  int64_t stat_ns;
+#endif
 };
 
 struct cx_fimp *cx_fimp_init(struct cx_fimp *imp,
@@ -40,6 +47,7 @@ struct cx_bin_fimp *cx_fimp_inline(struct cx_fimp *imp,
 				   struct cx *cx);
 
 bool cx_fimp_call(struct cx_fimp *imp, struct cx_scope *scope);
+void cx_fimp_native(struct cx_fimp *imp, const char *dir);
 
 struct cx_type *cx_init_fimp_type(struct cx_lib *lib);
 
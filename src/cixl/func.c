@@ -25,6 +25,9 @@ struct cx_func *cx_func_init(struct cx_func *func,
   func->emit_id = cx_emit_id("func", id);
   cx_set_init(&func->imps, sizeof(struct cx_fimp *), cx_cmp_cstr);
   func->imps.key = get_imp_id;
+  func->dispatch = NULL;
+  func->dispatch_epoch = func->ndispatch_slots = func->ndispatch = 0;
+  func->values = false;
   func->nargs = nargs;
   return func;
 }
@@ -33,6 +36,7 @@ struct cx_func *cx_func_deinit(struct cx_func *func) {
   free(func->id);
   free(func->emit_id);
   cx_set_deinit(&func->imps);
+  free(func->dispatch);
   return func; 
 }
 
@@ -42,6 +46,7 @@ bool cx_ensure_fimp(struct cx_func *func, struct cx_fimp *imp) {
   
   ok = cx_set_insert(&func->imps, &imp->id);
   *ok = imp;
+  func->lib->cx->dispatch_epoch++;
   return true;
 }
 
@@ -96,6 +101,7 @@ struct cx_fimp *cx_add_fimp(struct cx_func *func,
   *(struct cx_fimp **)cx_vec_push(&cx->fimps) = imp;
   *(struct cx_fimp **)cx_set_insert(&func->imps, &id.data) = imp;
   imp->args = imp_args;
+  cx->dispatch_epoch++;
 
   if (nrets) {
     cx_vec_grow(&imp->rets, nrets);
@@ -130,7 +136,7 @@ struct cx_fimp *cx_get_fimp(struct cx_func *func,
   return *imp;
 }
 
-struct cx_fimp *cx_func_match(struct cx_func *func, struct cx_scope *scope) {
+static struct cx_fimp *match_imps(struct cx_func *func, struct cx_scope *scope) {
   struct cx_fimp *best_match = NULL;
   ssize_t best_score = -1;
   
@@ -153,6 +159,108 @@ struct cx_fimp *cx_func_match(struct cx_func *func, struct cx_scope *scope) {
   return best_match;
 }
 
+static void reset_dispatch(struct cx_func *func, size_t epoch) {
+  if (func->ndispatch) {
+    memset(func->dispatch, 0,
+	   func->ndispatch_slots * sizeof(struct cx_func_dispatch));
+    func->ndispatch = 0;
+  }
+  
+  func->dispatch_epoch = epoch;
+  func->values = false;
+
+  cx_do_set(&func->imps, struct cx_fimp *, i) {
+    cx_do_vec(&(*i)->args, struct cx_arg, a) {
+      if (a->arg_type == CX_VARG) { func->values = true; }
+    }
+  }
+}
+
+static size_t hash_tags(const size_t *tags, int n) {
+  size_t h = 14695981039346656037ULL;
+  
+  for (int i = 0; i < n; i++) {
+    h ^= tags[i];
+    h *= 1099511628211ULL;
+  }
+
+  return h;
+}
+
+static struct cx_func_dispatch *find_dispatch(struct cx_func_dispatch *slots,
+					      size_t nslots,
+					      const size_t *tags,
+					      int n) {
+  size_t i = hash_tags(tags, n) & (nslots-1);
+  struct cx_func_dispatch *d = slots+i;
+  
+  for (; d->imp; i = (i+1) & (nslots-1), d = slots+i) {
+    if (memcmp(d->tags, tags, n*sizeof(size_t)) == 0) { break; }
+  }
+
+  return d;
+}
+
+static void grow_dispatch(struct cx_func *func) {
+  size_t nslots = func->ndispatch_slots ? func->ndispatch_slots*2 : 8;
+  struct cx_func_dispatch
+    *slots = calloc(nslots, sizeof(struct cx_func_dispatch)),
+    *end = func->dispatch+func->ndispatch_slots;
+
+  for (struct cx_func_dispatch *d = func->dispatch; d < end; d++) {
+    if (d->imp) { *find_dispatch(slots, nslots, d->tags, func->nargs) = *d; }
+  }
+
+  free(func->dispatch);
+  func->dispatch = slots;
+  func->ndispatch_slots = nslots;
+}
+
+struct cx_fimp *cx_func_match(struct cx_func *func, struct cx_scope *scope) {
+  struct cx *cx = func->lib->cx;
+  struct cx_vec *stack = &scope->stack;
+  
+  if (func->dispatch_epoch != cx->dispatch_epoch) {
+    reset_dispatch(func, cx->dispatch_epoch);
+  }
+  
+  if (func->values || stack->count < func->nargs) {
+    return match_imps(func, scope);
+  }
+  
+  size_t tags[CX_MAX_ARGS];
+  struct cx_box *args = (struct cx_box *)cx_vec_end(stack) - func->nargs;
+  for (int i = 0; i < func->nargs; i++) { tags[i] = args[i].type->tag; }
+  struct cx_func_dispatch *d = NULL;
+
+  if (func->ndispatch) {
+    d = find_dispatch(func->dispatch, func->ndispatch_slots, tags, func->nargs);
+    
+    if (d->imp) {
+      cx->dispatch_hits++;
+      return d->imp;
+    }
+  }
+
+  cx->dispatch_misses++;
+  struct cx_fimp *imp = match_imps(func, scope);
+  if (!imp) { return NULL; }
+  
+  if (2*(func->ndispatch+1) > func->ndispatch_slots) {
+    grow_dispatch(func);
+    d = NULL;
+  }
+
+  if (!d) {
+    d = find_dispatch(func->dispatch, func->ndispatch_slots, tags, func->nargs);
+  }
+
+  memcpy(d->tags, tags, func->nargs*sizeof(size_t));
+  d->imp = imp;
+  func->ndispatch++;
+  return imp;
+}
+
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
   return x->as_ptr == y->as_ptr;
 }
@@ -3,6 +3,7 @@
 
 #include <stdarg.h>
 
+#include "cixl/arg.h"
 #include "cixl/set.h"
 
 struct cx_arg;
@@ -10,10 +11,21 @@ struct cx_fimp;
 struct cx_scope;
 struct cx_type;
 
+struct cx_func_dispatch {
+  size_t tags[CX_MAX_ARGS];
+  struct cx_fimp *imp;
+};
+
+// Dispatch tables map the type tags of args to imps using open addressing,
+// empty slots have no imp.
+
 struct cx_func {
   struct cx_lib *lib;
   char *id, *emit_id;
   struct cx_set imps;
+  struct cx_func_dispatch *dispatch;
+  size_t dispatch_epoch, ndispatch_slots, ndispatch;
+  bool values;
   int nargs;
 };
 
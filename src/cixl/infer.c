@@ -0,0 +1,200 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cixl/bin.h"
+#include "cixl/cx.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/infer.h"
+#include "cixl/lib.h"
+#include "cixl/op.h"
+#include "cixl/peephole.h"
+#include "cixl/type.h"
+#include "cixl/util.h"
+
+#define CX_INFER_DEPTH 32
+
+// Derived types don't matter here, emitted code checks the exact type of each
+// value before taking a specialized path.
+
+static bool is_exact(struct cx_type *t) {
+  return t &&
+    (t->meta == CX_TYPE_IMP || t->meta == CX_TYPE_REC) &&
+    !t->args.count;
+}
+
+static ssize_t score_imp(struct cx_fimp *imp, struct cx_type **args) {
+  int nargs = imp->func->nargs;
+  ssize_t score = 0;
+  
+  struct cx_type *get_imp_arg(int i) {
+    return (i < nargs)
+      ? ((struct cx_arg *)cx_vec_get(&imp->args, i))->type
+      : NULL;
+  }
+
+  struct cx_type *get_arg(int i) { return (i < nargs) ? args[i] : NULL; }
+
+  for (int i = 0; i < nargs; i++) {
+    struct cx_arg *a = cx_vec_get(&imp->args, i);
+    if (a->arg_type == CX_VARG) { return -1; }
+    struct cx_type *t = cx_resolve_arg_refs(a->type, get_imp_arg, get_arg);
+    if (!t || !cx_is(args[i], t)) { return -1; }
+    score += cx_abs((ssize_t)(args[i]->level - t->level));
+  }
+
+  return score;
+}
+
+static struct cx_fimp *match(struct cx_op *op, struct cx_type **args) {
+  struct cx_func *func = op->as_funcall.func;
+  struct cx_fimp *imp = op->as_funcall.imp;
+  
+  if (imp && score_imp(imp, args) > -1) { return imp; }
+  struct cx_fimp *best_match = NULL;
+  ssize_t best_score = -1;
+
+  cx_do_set(&func->imps, struct cx_fimp *, i) {
+    cx_do_vec(&(*i)->args, struct cx_arg, a) {
+      if (a->arg_type == CX_VARG) { return NULL; }
+    }
+  }
+
+  cx_do_set(&func->imps, struct cx_fimp *, i) {
+    ssize_t s = score_imp(*i, args);
+
+    switch (s) {
+    case -1:
+      continue;
+    case 0:
+      return *i;
+    }
+
+    if (best_score == -1 || best_score > s) {
+      best_match = *i;
+      best_score = s;
+    }
+  }
+
+  return best_match;
+}
+
+static bool is_let(struct cx_op *op) {
+  if (op->type != CX_OFUNCALL()) { return false; }
+  struct cx_func *f = op->as_funcall.func;
+  return strcmp(f->lib->id.id, "cx/var") == 0 && strcmp(f->id, "let") == 0;
+}
+
+struct cx_infer *cx_infer(struct cx *cx, struct cx_bin *bin) {
+  struct cx_infer *out = calloc(bin->ops.count+1, sizeof(struct cx_infer));
+  size_t *ts = cx_find_targets(cx, bin, 0);
+  struct cx_type *stack[CX_INFER_DEPTH];
+  int n = 0;
+  struct cx_fimp *env = NULL;
+  size_t env_end = 0;
+  bool env_ok[CX_MAX_ARGS];
+
+  void push(struct cx_type *t) {
+    if (n == CX_INFER_DEPTH) {
+      memmove(stack, stack+1, (n-1)*sizeof(struct cx_type *));
+      n--;
+    }
+    
+    stack[n++] = is_exact(t) ? t : NULL;
+  }
+
+  struct cx_type *pop() { return n ? stack[--n] : NULL; }
+
+  struct cx_type *get_var(struct cx_sym id) {
+    if (!env) { return NULL; }
+    struct cx_arg *a = cx_vec_start(&env->args);
+    
+    for (size_t i = 0; i < env->args.count; i++, a++) {
+      if (env_ok[i] && a->sym_id.tag == id.tag) { return a->type; }
+    }
+
+    return NULL;
+  }
+
+  void begin_env(struct cx_fimp *imp, size_t start_pc, size_t end_pc) {
+    env = imp;
+    env_end = end_pc;
+    struct cx_arg *a = cx_vec_start(&imp->args);
+    
+    for (size_t i = 0; i < imp->args.count; i++, a++) {
+      env_ok[i] = a->id && a->arg_type == CX_ARG && is_exact(a->type);
+    }
+
+    for (size_t i = start_pc; i < end_pc; i++) {
+      struct cx_op *op = cx_vec_get(&bin->ops, i);
+
+      if (is_let(op)) {
+	memset(env_ok, 0, sizeof(env_ok));
+	break;
+      }
+      
+      if (op->type == CX_OPUTVAR()) {
+	a = cx_vec_start(&imp->args);
+	
+	for (size_t j = 0; j < imp->args.count; j++, a++) {
+	  if (a->id && a->sym_id.tag == op->as_putvar.id.tag) { env_ok[j] = false; }
+	}
+      }
+    }
+  }
+  
+  for (size_t pc = 0; pc < bin->ops.count; pc++) {
+    struct cx_op *op = cx_vec_get(&bin->ops, pc);
+    if (ts[pc]) { n = 0; }
+    if (env && pc >= env_end) { env = NULL; }
+    
+    if (op->type == CX_OPUSH()) {
+      push(op->as_push.value.type);
+    } else if (op->type == CX_OPUSHCALL()) {
+      push(cx->int_type);
+    } else if (op->type == CX_OGETVAR() || op->type == CX_OGETCALL()) {
+      push(get_var(op->as_getvar.id));
+    } else if (op->type == CX_OBEGIN()) {
+      n = 0;
+      struct cx_fimp *imp = op->as_begin.fimp;
+      if (imp && !op->as_begin.child) { begin_env(imp, pc, pc+1+op->as_begin.nops); }
+    } else if (op->type == CX_OPUTARGS()) {
+      cx_do_vec(&op->as_putargs.imp->args, struct cx_arg, a) {
+	if (a->arg_type == CX_ARG && !a->id) { push(a->type); }
+      }
+    } else if (op->type == CX_OFUNCALL()) {
+      struct cx_infer *i = out+pc;
+      int nargs = op->as_funcall.func->nargs;
+      bool known = true;
+      
+      for (int j = nargs-1; j >= 0; j--) {
+	if (!(i->args[j] = pop())) { known = false; }
+      }
+
+      struct cx_fimp *imp = i->imp = known ? match(op, i->args) : NULL;
+
+      if (imp && (imp->pure || !imp->ptr)) {
+	struct cx_type *get_imp_arg(int j) {
+	  return (j < nargs)
+	    ? ((struct cx_arg *)cx_vec_get(&imp->args, j))->type
+	    : NULL;
+	}
+
+	struct cx_type *get_arg(int j) { return (j < nargs) ? i->args[j] : NULL; }
+
+	cx_do_vec(&imp->rets, struct cx_arg, r) {
+	  push((r->arg_type == CX_ARG)
+	       ? cx_resolve_arg_refs(r->type, get_imp_arg, get_arg)
+	       : r->value.type);
+	}
+      } else {
+	n = 0;
+      }
+    } else {
+      n = 0;
+    }
+  }
+  
+  free(ts);
+  return out;
+}
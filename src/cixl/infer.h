@@ -0,0 +1,18 @@
+#ifndef CX_INFER_H
+#define CX_INFER_H
+
+#include "cixl/arg.h"
+
+struct cx;
+struct cx_bin;
+struct cx_fimp;
+struct cx_type;
+
+struct cx_infer {
+  struct cx_fimp *imp;
+  struct cx_type *args[CX_MAX_ARGS];
+};
+
+struct cx_infer *cx_infer(struct cx *cx, struct cx_bin *bin);
+
+#endif
@@ -11,6 +11,7 @@
 #include "cixl/rec.h"
 #include "cixl/parse.h"
 #include "cixl/set.h"
+#include "cixl/timer.h"
 
 struct cx_lib_init cx_lib_ptr(cx_lib_init_ptr_t ptr) {
   return (struct cx_lib_init){
@@ -51,6 +52,7 @@ struct cx_lib *cx_lib_init(struct cx_lib *lib, struct cx *cx, struct cx_sym id)
   lib->emit_id = cx_emit_id("lib", id.id);
 
   cx_vec_init(&lib->inits, sizeof(struct cx_lib_init));
+  lib->init_ns = 0;
   
   cx_set_init(&lib->types, sizeof(struct cx_type *), cx_cmp_cstr);
   lib->types.key = get_type_id;
@@ -286,6 +288,16 @@ struct cx_fimp *cx_add_cfunc(struct cx_lib *lib,
   return imp;
 }
 
+struct cx_fimp *cx_add_pure_cfunc(struct cx_lib *lib,
+				  const char *id,
+				  int nargs, struct cx_arg *args,
+				  int nrets, struct cx_arg *rets,
+				  cx_fimp_ptr_t ptr) {
+  struct cx_fimp *imp = cx_add_cfunc(lib, id, nargs, args, nrets, rets, ptr);
+  if (imp) { imp->pure = true; }
+  return imp;
+}
+
 struct cx_fimp *cx_add_cxfunc(struct cx_lib *lib,
 			      const char *id,
 			      int nargs, struct cx_arg *args,
@@ -359,6 +371,7 @@ struct cx_box *cx_lib_get_const(struct cx_lib *lib, struct cx_sym id, bool silen
 
 struct cx_box *cx_put_const(struct cx_lib *lib, struct cx_sym id, bool force) {
   struct cx_var *v = cx_env_get(&lib->consts, id);
+  if (!v || force) { lib->cx->const_epoch++; }
 
   if (v) {
     if (!force) { return NULL; }
@@ -403,7 +416,11 @@ static bool use_func(struct cx_func *f, struct cx_lib *dst) {
 
 static void use_const(struct cx_var *v, struct cx_lib *dst) {
   struct cx_var *prev = cx_env_get(&dst->consts, v->id);
-  if (!prev) { cx_copy(cx_env_put(&dst->consts, v->id), &v->value); }
+  
+  if (!prev) {
+    cx_copy(cx_env_put(&dst->consts, v->id), &v->value);
+    dst->cx->const_epoch++;
+  }
 }
 
 static bool use_all(struct cx_lib *lib) {
@@ -453,27 +470,45 @@ static bool use_id(struct cx_lib *lib, const char *id) {
   return false;
 }
 
-bool cx_lib_vuse(struct cx_lib *lib, unsigned int nids, const char **ids) {
+bool cx_ensure_lib(struct cx_lib *lib) {
   struct cx *cx = lib->cx;
+  bool done = true;
+  
+  cx_do_vec(&lib->inits, struct cx_lib_init, i) {
+    if (!i->done) {
+      done = false;
+      break;
+    }
+  }
+
+  if (done) { return true; }
   bool ok = true;
+  cx_timer_t t;
+  cx_timer_reset(&t);
+  int64_t prev_ns = cx->lib_init_ns;
+  cx_push_lib(cx, lib);
   
-  if (lib->inits.count) {
-    cx_push_lib(cx, lib);
+  cx_do_vec(&lib->inits, struct cx_lib_init, i) {
+    if (i->done) { continue; }
     
-    cx_do_vec(&lib->inits, struct cx_lib_init, i) {
-      if (i->done) { continue; }
-      
-      if (i->ptr) {
-	ok = i->ptr(lib) && ok;
-      } else {
-	ok = cx_eval(i->bin, i->start_pc, i->start_pc+i->nops, cx) && ok;
-      }
-      
-      i->done = true;
+    if (i->ptr) {
+      ok = i->ptr(lib) && ok;
+    } else {
+      ok = cx_eval(i->bin, i->start_pc, i->start_pc+i->nops, cx) && ok;
     }
     
-    cx_pop_lib(cx);
+    i->done = true;
   }
+  
+  cx_pop_lib(cx);
+  int64_t ns = cx_timer_ns(&t);
+  lib->init_ns += ns - (cx->lib_init_ns - prev_ns);
+  cx->lib_init_ns = prev_ns + ns;
+  return ok;
+}
+
+bool cx_lib_vuse(struct cx_lib *lib, unsigned int nids, const char **ids) {
+  bool ok = cx_ensure_lib(lib);
 
   if (nids) {
     for (unsigned int i = 0; i < nids; i++) {
@@ -2,6 +2,7 @@
 #define CX_LIB_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "cixl/env.h"
 #include "cixl/fimp.h"
@@ -59,6 +60,7 @@ struct cx_lib {
   struct cx_sym id;
   char *emit_id;
   struct cx_vec inits;
+  int64_t init_ns;
 
   struct cx_set types,
     rmacros,
@@ -71,6 +73,7 @@ struct cx_lib *cx_lib_init(struct cx_lib *lib, struct cx *cx, struct cx_sym id);
 struct cx_lib *cx_lib_deinit(struct cx_lib *lib);
 
 void cx_lib_push_init(struct cx_lib *lib, struct cx_lib_init init);
+bool cx_ensure_lib(struct cx_lib *lib);
 bool cx_lib_push_type(struct cx_lib *l, struct cx_type *t);
 
 struct cx_type *_cx_add_type(struct cx_lib *lib, const char *id, ...);
@@ -96,6 +99,12 @@ struct cx_fimp *cx_add_cfunc(struct cx_lib *lib,
 			     int nrets, struct cx_arg *rets,
 			     cx_fimp_ptr_t ptr);
 
+struct cx_fimp *cx_add_pure_cfunc(struct cx_lib *lib,
+				  const char *id,
+				  int nargs, struct cx_arg *args,
+				  int nrets, struct cx_arg *rets,
+				  cx_fimp_ptr_t ptr);
+
 struct cx_fimp *cx_add_cxfunc(struct cx_lib *lib,
 			      const char *id,
 			      int nargs, struct cx_arg *args,
@@ -0,0 +1,119 @@
+#include <stdlib.h>
+
+#include "cixl/arg.h"
+#include "cixl/bench.h"
+#include "cixl/call.h"
+#include "cixl/cx.h"
+#include "cixl/error.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/lib.h"
+#include "cixl/lib/bench.h"
+#include "cixl/scope.h"
+#include "cixl/stack.h"
+
+static bool bench_imp(struct cx_call *call) {
+  struct cx_box
+    *act = cx_test(cx_call_arg(call, 2)),
+    *reps = cx_test(cx_call_arg(call, 1)),
+    *warmup = cx_test(cx_call_arg(call, 0));
+
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_bench b;
+  cx_bench_init(&b, "");
+  bool ok = cx_bench_call(&b, warmup->as_int, reps->as_int, act, s);
+
+  if (ok) {
+    struct cx_stack *out = cx_stack_new(cx);
+
+    cx_do_vec(&b.samples, int64_t, v) {
+      cx_box_init(cx_vec_push(&out->imp), cx->int_type)->as_int = *v;
+    }
+
+    cx_box_init(cx_push(s), cx_type_get(cx->stack_type, cx->int_type))->as_ptr =
+      out;
+  }
+
+  cx_bench_deinit(&b);
+  return ok;
+}
+
+static int64_t *get_samples(struct cx_call *call) {
+  struct cx_stack *s = cx_test(cx_call_arg(call, 0))->as_ptr;
+  struct cx *cx = s->cx;
+  int64_t *out = malloc(s->imp.count*sizeof(int64_t)), *o = out;
+
+  cx_do_vec(&s->imp, struct cx_box, v) {
+    if (v->type != cx->int_type) {
+      cx_error(cx, cx->row, cx->col, "Expected Int, actual: %s", v->type->id);
+      free(out);
+      return NULL;
+    }
+
+    *o++ = v->as_int;
+  }
+
+  return out;
+}
+
+static bool median_imp(struct cx_call *call) {
+  struct cx_stack *in = cx_test(cx_call_arg(call, 0))->as_ptr;
+  size_t n = in->imp.count;
+  struct cx_scope *s = call->scope;
+  int64_t m = 0;
+  
+  if (n) {
+    int64_t *xs = get_samples(call);
+    if (!xs) { return false; }
+    m = cx_median(xs, n);
+    free(xs);
+  }
+  
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = m;
+  return true;
+}
+
+static bool mad_imp(struct cx_call *call) {
+  struct cx_stack *in = cx_test(cx_call_arg(call, 0))->as_ptr;
+  size_t n = in->imp.count;
+  struct cx_scope *s = call->scope;
+  int64_t m = 0;
+  
+  if (n) {
+    int64_t *xs = get_samples(call);
+    if (!xs) { return false; }
+    m = cx_mad(xs, n, cx_median(xs, n));
+    free(xs);
+  }
+  
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = m;
+  return true;
+}
+
+cx_lib(cx_init_bench, "cx/bench") {
+  struct cx *cx = lib->cx;
+    
+  if (!cx_use(cx, "cx/abc", "A", "Int", "Stack")) {
+    return false;
+  }
+
+  cx_add_cfunc(lib, "bench",
+	       cx_args(cx_arg("warmup", cx->int_type),
+		       cx_arg("reps", cx->int_type),
+		       cx_arg("act", cx->any_type)),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->int_type))),
+	       bench_imp);
+
+  cx_add_cfunc(lib, "median",
+	       cx_args(cx_arg("s", cx->stack_type)),
+	       cx_args(cx_arg(NULL, cx->int_type)),
+	       median_imp);
+
+  cx_add_cfunc(lib, "mad",
+	       cx_args(cx_arg("s", cx->stack_type)),
+	       cx_args(cx_arg(NULL, cx->int_type)),
+	       mad_imp);
+
+  return true;
+}
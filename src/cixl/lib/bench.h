@@ -0,0 +1,9 @@
+#ifndef CX_LIB_BENCH_H
+#define CX_LIB_BENCH_H
+
+struct cx;
+struct cx_lib;
+
+struct cx_lib *cx_init_bench(struct cx *cx);
+
+#endif
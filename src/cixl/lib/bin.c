@@ -11,8 +11,13 @@
 #include "cixl/func.h"
 #include "cixl/lib.h"
 #include "cixl/lib/bin.h"
+#include "cixl/op.h"
 #include "cixl/mfile.h"
+#include "cixl/pair.h"
+#include "cixl/peephole.h"
 #include "cixl/scope.h"
+#include "cixl/stack.h"
+#include "cixl/stats.h"
 #include "cixl/str.h"
 
 static bool compile_imp(struct cx_call *call) {  
@@ -23,7 +28,7 @@ static bool compile_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   struct cx_vec toks;
   cx_vec_init(&toks, sizeof(struct cx_tok));
-  bool ok = cx_parse_str(s->cx, in->as_str->data, &toks, true);
+  bool ok = cx_parse_str(s->cx, cx_str_cstr(in->as_str), &toks, true);
   if (!ok) { goto exit; }
   
   struct cx_bin *bin = out->as_ptr;
@@ -47,7 +52,7 @@ static bool emit_imp(struct cx_call *call) {
   bool ok = cx_emit(bin, out.stream, s->cx);
   if (!ok) { goto exit; }
   fflush(out.stream);
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(out.data, out.size);
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, out.data, out.size);
   ok = true;
  exit:
   cx_mfile_close(&out);
@@ -55,6 +60,133 @@ static bool emit_imp(struct cx_call *call) {
   return ok;
 }
 
+static bool peephole_imp(struct cx_call *call) {
+  struct cx_box *on = cx_test(cx_call_arg(call, 0));
+  call->scope->cx->peephole.enabled = on->as_bool;
+  return true;
+}
+
+static bool peephole_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_peephole *p = &cx->peephole;
+  struct cx_stack *out = cx_stack_new(cx);
+  cx_push_stat(out, "fold", p->folds, cx);
+  cx_push_stat(out, "push-call", p->push_calls, cx);
+  cx_push_stat(out, "get-call", p->get_calls, cx);
+  cx_push_stat(out, "push-put", p->push_puts, cx);
+  cx_push_stat(out, "scope", p->scopes, cx);
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool funcall_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+  cx_push_stat(out, "hits", cx->funcall_hits, cx);
+  cx_push_stat(out, "misses", cx->funcall_misses, cx);
+  cx_push_stat(out, "dispatch-hits", cx->dispatch_hits, cx);
+  cx_push_stat(out, "dispatch-misses", cx->dispatch_misses, cx);
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool op_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+
+#ifdef CX_STATS
+  for (struct cx_op_type *t = cx_op_types; t; t = t->next) {
+    if (t->nevals) { cx_push_stat(out, t->id, t->nevals, cx); }
+  }
+#endif
+  
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool fimp_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+
+#ifdef CX_STATS
+  struct cx_type
+    *vt = cx_type_get(cx->pair_type, cx->int_type, cx->int_type),
+    *t = cx_type_get(cx->pair_type, cx->fimp_type, vt);
+
+  cx_do_vec(&cx->fimps, struct cx_fimp *, i) {
+    struct cx_fimp *imp = *i;
+    if (!imp->stat_calls) { continue; }
+    struct cx_pair *p = cx_pair_new(cx, NULL, NULL), *v = cx_pair_new(cx, NULL, NULL);
+    cx_box_init(&v->a, cx->int_type)->as_int = imp->stat_calls;
+    cx_box_init(&v->b, cx->int_type)->as_int = imp->stat_ns;
+    cx_box_init(&p->a, cx->fimp_type)->as_ptr = imp;
+    cx_box_init(&p->b, vt)->as_pair = v;
+    cx_box_init(cx_vec_push(&out->imp), t)->as_pair = p;
+  }
+#endif
+  
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool alloc_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+
+#ifdef CX_STATS
+  cx_push_stat(out, "scope", cx->nscopes, cx);
+  cx_push_stat(out, "box", cx->nboxes, cx);
+  cx_push_stat(out, "push", cx->npushes, cx);
+#endif
+  
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool sym_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_sym_table *t = &cx->syms;
+  struct cx_stack *out = cx_stack_new(cx);
+  cx_push_stat(out, "count", t->count, cx);
+  cx_push_stat(out, "slots", t->nslots, cx);
+  cx_push_stat(out, "lookups", t->nlookups, cx);
+  cx_push_stat(out, "probes", t->nprobes, cx);
+  cx_push_stat(out, "max-probes", t->max_probes, cx);
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
+static bool reset_stats_imp(struct cx_call *call) {
+  struct cx *cx = call->scope->cx;
+  struct cx_peephole *p = &cx->peephole;
+  p->folds = p->push_calls = p->get_calls = p->push_puts = p->scopes = 0;
+  cx->funcall_hits = cx->funcall_misses = 0;
+  cx->dispatch_hits = cx->dispatch_misses = 0;
+  cx->syms.nlookups = cx->syms.nprobes = cx->syms.max_probes = 0;
+
+  struct cx_malloc *a = NULL;
+  for (size_t i = 0; (a = cx_get_alloc(cx, i, NULL)); i++) { a->max_live = a->nlive; }
+
+#ifdef CX_STATS
+  for (struct cx_op_type *t = cx_op_types; t; t = t->next) { t->nevals = 0; }
+
+  cx_do_vec(&cx->fimps, struct cx_fimp *, i) {
+    (*i)->stat_calls = 0;
+    (*i)->stat_ns = 0;
+  }
+  
+  cx->nscopes = cx->nboxes = cx->npushes = 0;
+#endif
+  
+  return true;
+}
+
 static bool bor_imp(struct cx_call *call) {
   struct cx_box
     *x = cx_test(cx_call_arg(call, 1)),
@@ -79,7 +211,8 @@ static bool bsh_imp(struct cx_call *call) {
 cx_lib(cx_init_bin, "cx/bin") {
   struct cx *cx = lib->cx;
     
-  if (!cx_use(cx, "cx/abc", "A", "Str")) {
+  if (!cx_use(cx, "cx/abc", "A", "Bool", "Str", "Sym") ||
+      !cx_use(cx, "cx/pair", "Pair")) {
     return false;
   }
 
@@ -95,15 +228,55 @@ cx_lib(cx_init_bin, "cx/bin") {
 	       cx_args(cx_arg(NULL, cx->str_type)),
 	       emit_imp);
 
-  cx_add_cfunc(lib, "bor",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       bor_imp);
+  cx_add_cfunc(lib, "peephole",
+	       cx_args(cx_arg("on", cx->bool_type)),
+	       cx_args(),
+	       peephole_imp);
+
+  cx_add_cfunc(lib, "peephole-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       peephole_stats_imp);
+
+  cx_add_cfunc(lib, "funcall-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       funcall_stats_imp);
+
+  cx_add_cfunc(lib, "op-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       op_stats_imp);
+
+  cx_add_cfunc(lib, "fimp-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       fimp_stats_imp);
+
+  cx_add_cfunc(lib, "alloc-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       alloc_stats_imp);
+
+  cx_add_cfunc(lib, "sym-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       sym_stats_imp);
+
+  cx_add_cfunc(lib, "reset-stats",
+	       cx_args(),
+	       cx_args(),
+	       reset_stats_imp);
+
+  cx_add_pure_cfunc(lib, "bor",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    bor_imp);
 
-  cx_add_cfunc(lib, "bsh",
-	       cx_args(cx_arg("val", cx->int_type), cx_arg("delta", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       bsh_imp);
+  cx_add_pure_cfunc(lib, "bsh",
+		    cx_args(cx_arg("val", cx->int_type), cx_arg("delta", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    bsh_imp);
 
   return true;
 }
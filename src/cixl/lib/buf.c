@@ -40,7 +40,7 @@ static bool str_imp(struct cx_call *call) {
   struct cx_buf *b = cx_baseof(in->as_file, struct cx_buf, file);
   fflush(b->file._ptr);
   cx_box_init(cx_push(s), s->cx->str_type)->as_str =
-    cx_str_new(b->data+b->pos, b->len-b->pos);
+    cx_str_new(s->cx, b->data+b->pos, b->len-b->pos);
   return true;
 }
 
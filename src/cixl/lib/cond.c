@@ -15,7 +15,8 @@ static ssize_t switch_eval(struct cx_rmacro_eval *eval,
 			   struct cx_bin *bin,
 			   size_t tok_idx,
 			   struct cx *cx) {
-  size_t start = bin->ops.count;
+  struct cx_vec jumps;
+  cx_vec_init(&jumps, sizeof(size_t));
   
   for (struct cx_tok *t = cx_vec_start(&eval->toks);
        t != cx_vec_end(&eval->toks);
@@ -33,17 +34,19 @@ static ssize_t switch_eval(struct cx_rmacro_eval *eval,
     size_t ei = bin->ops.count;
     cx_op_new(bin, CX_OELSE(), tok_idx);
     cx_compile(cx, cx_vec_get(ts, 1), cx_vec_end(ts), bin);
+    *(size_t *)cx_vec_push(&jumps) = bin->ops.count;
     cx_op_new(bin, CX_OJUMP(), tok_idx);
 
     struct cx_op *eop = cx_vec_get(&bin->ops, ei);
     eop->as_else.nops = bin->ops.count-ei-1;
   }
 
-  for (struct cx_op *op = cx_vec_get(&bin->ops, start);
-       op != cx_vec_end(&bin->ops);
-       op++) {    
-    if (op->type == CX_OJUMP()) { op->as_jump.pc = bin->ops.count; }
+  cx_do_vec(&jumps, size_t, i) {
+    struct cx_op *op = cx_vec_get(&bin->ops, *i);
+    op->as_jump.pc = bin->ops.count;
   }
+
+  cx_vec_deinit(&jumps);
   
   return tok_idx+1;
 }
@@ -67,7 +70,7 @@ static bool switch_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     }
   }
   
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
  error:
   cx_rmacro_eval_deref(eval);
@@ -101,17 +104,17 @@ static bool equid_imp(struct cx_call *call) {
   return true;
 }
 
-static struct cx_sym cmp_sym(struct cx *cx, enum cx_cmp cmp) {
+static struct cx_sym *cmp_sym(struct cx *cx, enum cx_cmp cmp) {
   switch (cmp) {
   case CX_CMP_LT:
-    return cx_sym(cx, "<");
+    return cx_intern(cx, "<");
   case CX_CMP_EQ:
-    return cx_sym(cx, "=");
+    return cx_intern(cx, "=");
   default:
     break;
   }
 
-  return cx_sym(cx, ">");
+  return cx_intern(cx, ">");
 }
 
 static bool cmp_imp(struct cx_call *call) {
@@ -319,55 +322,55 @@ cx_lib(cx_init_cond, "cx/cond") {
 
   cx_add_rmacro(lib, "switch:", switch_parse);
   
-  cx_add_cfunc(lib, "int",
-	       cx_args(cx_arg("v", cx->bool_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_imp);
-
-  cx_add_cfunc(lib, "=",
-	       cx_args(cx_arg("x", cx->opt_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       eqval_imp);
+  cx_add_pure_cfunc(lib, "int",
+		    cx_args(cx_arg("v", cx->bool_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_imp);
+
+  cx_add_pure_cfunc(lib, "=",
+		    cx_args(cx_arg("x", cx->opt_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    eqval_imp);
   
   cx_add_cfunc(lib, "==",
 	       cx_args(cx_arg("x", cx->opt_type), cx_narg(cx, "y", 0)),
 	       cx_args(cx_arg(NULL, cx->bool_type)),
 	       equid_imp);
 
-  cx_add_cfunc(lib, "<=>",
-	       cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->sym_type)),
-	       cmp_imp);
+  cx_add_pure_cfunc(lib, "<=>",
+		    cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->sym_type)),
+		    cmp_imp);
   
-  cx_add_cfunc(lib, "<",
-	       cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       lt_imp);
+  cx_add_pure_cfunc(lib, "<",
+		    cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    lt_imp);
   
-  cx_add_cfunc(lib, ">",
-	       cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       gt_imp);
+  cx_add_pure_cfunc(lib, ">",
+		    cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    gt_imp);
   
-  cx_add_cfunc(lib, "<=",
-	       cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       lte_imp);
+  cx_add_pure_cfunc(lib, "<=",
+		    cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    lte_imp);
   
-  cx_add_cfunc(lib, ">=",
-	       cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       gte_imp);
+  cx_add_pure_cfunc(lib, ">=",
+		    cx_args(cx_arg("x", cx->cmp_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    gte_imp);
   
-  cx_add_cfunc(lib, "?",
-	       cx_args(cx_arg("v", cx->opt_type)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       ok_imp);
+  cx_add_pure_cfunc(lib, "?",
+		    cx_args(cx_arg("v", cx->opt_type)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    ok_imp);
   
-  cx_add_cfunc(lib, "!",
-	       cx_args(cx_arg("v", cx->opt_type)),
-	       cx_args(cx_arg(NULL, cx->bool_type)),
-	       not_imp);
+  cx_add_pure_cfunc(lib, "!",
+		    cx_args(cx_arg("v", cx->opt_type)),
+		    cx_args(cx_arg(NULL, cx->bool_type)),
+		    not_imp);
   
   cx_add_cfunc(lib, "and",
 	       cx_args(cx_arg("x", cx->opt_type), cx_arg("y", cx->opt_type)),
@@ -395,15 +398,15 @@ cx_lib(cx_init_cond, "cx/cond") {
 	       cx_args(),
 	       if_else_imp);
 
-  cx_add_cfunc(lib, "min",
-	       cx_args(cx_arg("x", cx->any_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_narg(cx, NULL, 0)),
-	       min_imp);
+  cx_add_pure_cfunc(lib, "min",
+		    cx_args(cx_arg("x", cx->any_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_narg(cx, NULL, 0)),
+		    min_imp);
 
-  cx_add_cfunc(lib, "max",
-	       cx_args(cx_arg("x", cx->any_type), cx_narg(cx, "y", 0)),
-	       cx_args(cx_narg(cx, NULL, 0)),
-	       max_imp);
+  cx_add_pure_cfunc(lib, "max",
+		    cx_args(cx_arg("x", cx->any_type), cx_narg(cx, "y", 0)),
+		    cx_args(cx_narg(cx, NULL, 0)),
+		    max_imp);
 
   return true;
 }
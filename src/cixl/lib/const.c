@@ -143,7 +143,7 @@ static bool define_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     cx_vec_deinit(&toks);
     
     if (ok) {
-      cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+      cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
     } else {
       cx_rmacro_eval_deref(eval);
     }
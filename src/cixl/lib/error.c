@@ -87,7 +87,7 @@ static bool catch_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     return false;
   }
   
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
 }
 
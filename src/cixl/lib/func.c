@@ -202,15 +202,15 @@ static bool func_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   
   imp->toks = toks;
   struct cx_rmacro_eval *eval = cx_rmacro_eval_new(func_eval);
-  cx_tok_init(cx_vec_push(&eval->toks), CX_TFIMP(), row, col)->as_ptr = imp;
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(&eval->toks), CX_TFIMP(), cx->file, row, col)->as_ptr = imp;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
 }
 
 static bool func_id_imp(struct cx_call *call) {
   struct cx_func *f = cx_test(cx_call_arg(call, 0))->as_ptr;
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = cx_sym(s->cx, f->id);
+  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = cx_intern(s->cx, f->id);
   return true;
 }
 
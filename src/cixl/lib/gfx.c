@@ -1,3 +1,5 @@
+#include <inttypes.h>
+
 #include "cixl/arg.h"
 #include "cixl/call.h"
 #include "cixl/color.h"
@@ -15,7 +17,7 @@ static bool xy_int_imp(struct cx_call *call) {
     y = cx_test(cx_call_arg(call, 1))->as_int;
 
   struct cx_scope *s = call->scope;
-  cx_point_init(&cx_box_init(cx_push(s), s->cx->point_type)->as_point, x, y);
+  cx_box_init(cx_push(s), s->cx->point_type)->as_point = cx_point_new(s->cx, x, y);
   return true;
 }
 
@@ -25,32 +27,41 @@ static bool xy_float_imp(struct cx_call *call) {
     y = cx_test(cx_call_arg(call, 1))->as_float;
 
   struct cx_scope *s = call->scope;
-  cx_point_init(&cx_box_init(cx_push(s), s->cx->point_type)->as_point, x, y);
+  cx_box_init(cx_push(s), s->cx->point_type)->as_point = cx_point_new(s->cx, x, y);
   return true;
 }
 
 static bool x_imp(struct cx_call *call) {
-  struct cx_point *p = &cx_test(cx_call_arg(call, 0))->as_point;
+  struct cx_point *p = cx_test(cx_call_arg(call, 0))->as_point;
   struct cx_scope *s = call->scope;
   cx_box_init(cx_push(s), s->cx->float_type)->as_float = p->x;
   return true;
 }
 
 static bool y_imp(struct cx_call *call) {
-  struct cx_point *p = &cx_test(cx_call_arg(call, 0))->as_point;
+  struct cx_point *p = cx_test(cx_call_arg(call, 0))->as_point;
   struct cx_scope *s = call->scope;
   cx_box_init(cx_push(s), s->cx->float_type)->as_float = p->y;
   return true;
 }
 
 static bool point_splat_imp(struct cx_call *call) {
-  struct cx_point *p = &cx_test(cx_call_arg(call, 0))->as_point;
+  struct cx_point *p = cx_test(cx_call_arg(call, 0))->as_point;
   struct cx_scope *s = call->scope;
   cx_box_init(cx_push(s), s->cx->float_type)->as_float = p->x;
   cx_box_init(cx_push(s), s->cx->float_type)->as_float = p->y;
   return true;
 }
 
+static bool check_channel(struct cx *cx, struct cx_box *c) {
+  if (c->as_int < 0 || c->as_int > 255) {
+    cx_error(cx, cx->row, cx->col, "Invalid color channel: %" PRId64, c->as_int);
+    return false;
+  }
+
+  return true;
+}
+
 static bool rgb_imp(struct cx_call *call) {
   struct cx_box
     *r = cx_test(cx_call_arg(call, 0)),
@@ -59,6 +70,12 @@ static bool rgb_imp(struct cx_call *call) {
 
   struct cx_scope *s = call->scope;
 
+  if (!check_channel(s->cx, r) ||
+      !check_channel(s->cx, g) ||
+      !check_channel(s->cx, b)) {
+    return false;
+  }
+
   cx_color_init(&cx_box_init(cx_push(s), s->cx->color_type)->as_color,
 		r->as_int,
 		g->as_int,
@@ -77,6 +94,13 @@ static bool rgba_imp(struct cx_call *call) {
 
   struct cx_scope *s = call->scope;
 
+  if (!check_channel(s->cx, r) ||
+      !check_channel(s->cx, g) ||
+      !check_channel(s->cx, b) ||
+      !check_channel(s->cx, a)) {
+    return false;
+  }
+
   cx_color_init(&cx_box_init(cx_push(s), s->cx->color_type)->as_color,
 		r->as_int,
 		g->as_int,
@@ -63,7 +63,7 @@ static bool include_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     if (!ok) { goto exit2; }
   }
   
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   ok = true;
   goto exit1;
  exit2:
@@ -100,7 +100,18 @@ static bool line_next(struct cx_iter *iter,
       return false;
     }
   } else {
-    cx_box_init(out, cx->str_type)->as_str = cx_str_new(it->line, strlen(it->line));
+    size_t len = strlen(it->line);
+    struct cx_str *s = NULL;
+    
+    if (len > CX_STR_SHORT) {
+      s = cx_str_adopt(cx, it->line, len);
+      it->line = NULL;
+      it->len = 0;
+    } else {
+      s = cx_str_new(cx, it->line, len);
+    }
+    
+    cx_box_init(out, cx->str_type)->as_str = s;
   }
   
   return true;
@@ -263,7 +274,7 @@ static bool load_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   struct cx_bin *bin = cx_bin_new();
   struct cx_lib *lib = cx_pop_lib(s->cx);
-  bool ok = cx_load(s->cx, p->as_str->data, bin) && cx_eval(bin, 0, -1, s->cx);
+  bool ok = cx_load(s->cx, cx_str_cstr(p->as_str), bin) && cx_eval(bin, 0, -1, s->cx);
   cx_push_lib(s->cx, lib);
   cx_bin_deref(bin);
   return ok;
@@ -277,16 +288,16 @@ static bool fopen_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   struct cx_type *ft = NULL;
 
-  if (strchr(m->as_sym.id, 'r')) {
-    ft = strchr(m->as_sym.id, '+') ? s->cx->rwfile_type : s->cx->rfile_type;
-  } else if (strchr(m->as_sym.id, 'w') || strchr(m->as_sym.id, 'a')) {
-    ft = strchr(m->as_sym.id, '+') ? s->cx->rwfile_type : s->cx->wfile_type;
+  if (strchr(m->as_sym->id, 'r')) {
+    ft = strchr(m->as_sym->id, '+') ? s->cx->rwfile_type : s->cx->rfile_type;
+  } else if (strchr(m->as_sym->id, 'w') || strchr(m->as_sym->id, 'a')) {
+    ft = strchr(m->as_sym->id, '+') ? s->cx->rwfile_type : s->cx->wfile_type;
   } else {
-    cx_error(s->cx, s->cx->row, s->cx->col, "Invalid fopen mode: %s", m->as_sym.id);
+    cx_error(s->cx, s->cx->row, s->cx->col, "Invalid fopen mode: %s", m->as_sym->id);
     return false;
   }
 
-  FILE *f = fopen(p->as_str->data, m->as_sym.id);
+  FILE *f = fopen(cx_str_cstr(p->as_str), m->as_sym->id);
 
   if (f) {
     cx_box_init(cx_push(s), ft)->as_file = cx_file_new(s->cx, fileno(f), NULL, f);
@@ -294,7 +305,7 @@ static bool fopen_imp(struct cx_call *call) {
     if (errno != ENOENT) {
       cx_error(s->cx, s->cx->row, s->cx->col,
 	       "Failed opening file '%s': %d",
-	       p->as_str->data, errno);
+	       cx_str_cstr(p->as_str), errno);
       
       return false;
     }
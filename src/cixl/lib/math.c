@@ -229,120 +229,120 @@ cx_lib(cx_init_math, "cx/math") {
     return false;
   }
 
-  cx_add_cfunc(lib, "++",
-	       cx_args(cx_arg("v", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       inc_imp);
+  cx_add_pure_cfunc(lib, "++",
+		    cx_args(cx_arg("v", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    inc_imp);
   
-  cx_add_cfunc(lib, "--",
-	       cx_args(cx_arg("v", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       dec_imp);
-
-  cx_add_cfunc(lib, "+",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_add_imp);
+  cx_add_pure_cfunc(lib, "--",
+		    cx_args(cx_arg("v", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    dec_imp);
+
+  cx_add_pure_cfunc(lib, "+",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_add_imp);
   
-  cx_add_cfunc(lib, "-",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_sub_imp);
+  cx_add_pure_cfunc(lib, "-",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_sub_imp);
   
-  cx_add_cfunc(lib, "*",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_mul_imp);
+  cx_add_pure_cfunc(lib, "*",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_mul_imp);
   
-  cx_add_cfunc(lib, "/",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_div_imp);
-
-  cx_add_cfunc(lib, "**",
-	       cx_args(cx_arg("v", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_pow2_imp);
-
-  cx_add_cfunc(lib, "mod",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_mod_imp);
-
-  cx_add_cfunc(lib, "abs",
-	       cx_args(cx_arg("n", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       int_abs_imp);
+  cx_add_pure_cfunc(lib, "/",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_div_imp);
+
+  cx_add_pure_cfunc(lib, "**",
+		    cx_args(cx_arg("v", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_pow2_imp);
+
+  cx_add_pure_cfunc(lib, "mod",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_mod_imp);
+
+  cx_add_pure_cfunc(lib, "abs",
+		    cx_args(cx_arg("n", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    int_abs_imp);
 
   cx_add_cfunc(lib, "rand",
 	       cx_args(cx_arg("n", cx->int_type)),
 	       cx_args(cx_arg(NULL, cx->int_type)),
 	       rand_imp);
 
-  cx_add_cfunc(lib, "+",
-	       cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_add_imp);
-
-  cx_add_cfunc(lib, "-",
-	       cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_sub_imp);
-
-  cx_add_cfunc(lib, "-",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       int_float_sub_imp);
-
-  cx_add_cfunc(lib, "*",
-	       cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_mul_imp);
-
-  cx_add_cfunc(lib, "*2",
-	       cx_args(cx_arg("v", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_double_imp);
-
-  cx_add_cfunc(lib, "/",
-	       cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_div_imp);
-
-  cx_add_cfunc(lib, "/",
-	       cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_int_div_imp);
-
-  cx_add_cfunc(lib, "/",
-	       cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       int_float_div_imp);
-
-  cx_add_cfunc(lib, "**",
-	       cx_args(cx_arg("v", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       float_pow2_imp);
-
-  cx_add_cfunc(lib, "sqrt",
-	       cx_args(cx_arg("v", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       sqrt_imp);
-
-  cx_add_cfunc(lib, "log",
-	       cx_args(cx_arg("v", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       log_imp);
-
-  cx_add_cfunc(lib, "int",
-	       cx_args(cx_arg("v", cx->float_type)),
-	       cx_args(cx_arg(NULL, cx->int_type)),
-	       float_int_imp);
-
-  cx_add_cfunc(lib, "float",
-	       cx_args(cx_arg("v", cx->int_type)),
-	       cx_args(cx_arg(NULL, cx->float_type)),
-	       int_float_imp);
+  cx_add_pure_cfunc(lib, "+",
+		    cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_add_imp);
+
+  cx_add_pure_cfunc(lib, "-",
+		    cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_sub_imp);
+
+  cx_add_pure_cfunc(lib, "-",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    int_float_sub_imp);
+
+  cx_add_pure_cfunc(lib, "*",
+		    cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_mul_imp);
+
+  cx_add_pure_cfunc(lib, "*2",
+		    cx_args(cx_arg("v", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_double_imp);
+
+  cx_add_pure_cfunc(lib, "/",
+		    cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_div_imp);
+
+  cx_add_pure_cfunc(lib, "/",
+		    cx_args(cx_arg("x", cx->float_type), cx_arg("y", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_int_div_imp);
+
+  cx_add_pure_cfunc(lib, "/",
+		    cx_args(cx_arg("x", cx->int_type), cx_arg("y", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    int_float_div_imp);
+
+  cx_add_pure_cfunc(lib, "**",
+		    cx_args(cx_arg("v", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    float_pow2_imp);
+
+  cx_add_pure_cfunc(lib, "sqrt",
+		    cx_args(cx_arg("v", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    sqrt_imp);
+
+  cx_add_pure_cfunc(lib, "log",
+		    cx_args(cx_arg("v", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    log_imp);
+
+  cx_add_pure_cfunc(lib, "int",
+		    cx_args(cx_arg("v", cx->float_type)),
+		    cx_args(cx_arg(NULL, cx->int_type)),
+		    float_int_imp);
+
+  cx_add_pure_cfunc(lib, "float",
+		    cx_args(cx_arg("v", cx->int_type)),
+		    cx_args(cx_arg(NULL, cx->float_type)),
+		    int_float_imp);
 
   cx_add_cxfunc(lib, "fib-rec",
 		cx_args(cx_arg("a", cx->int_type),
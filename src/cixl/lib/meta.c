@@ -10,7 +10,9 @@
 #include "cixl/lib.h"
 #include "cixl/lib/meta.h"
 #include "cixl/op.h"
+#include "cixl/pair.h"
 #include "cixl/scope.h"
+#include "cixl/stack.h"
 #include "cixl/str.h"
 
 static ssize_t lib_eval(struct cx_rmacro_eval *eval,
@@ -60,7 +62,7 @@ static bool lib_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
 
   struct cx_lib *lib = cx_add_lib(cx, id->as_ptr);
   cx_tok_deinit(id);
-  cx_tok_init(id, CX_TLIB(), id->row, id->col)->as_lib = lib;
+  cx_tok_init(id, CX_TLIB(), id->file, id->row, id->col)->as_lib = lib;
   struct cx_lib *prev = *cx->lib;
   cx_push_lib(cx, lib);
   cx_lib_use(prev);
@@ -74,7 +76,7 @@ static bool lib_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   }
 
   cx_pop_lib(cx);
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
 }
 
@@ -145,7 +147,7 @@ static bool use_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     }        
   }
   
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
 }
 
@@ -158,16 +160,17 @@ static bool this_lib_imp(struct cx_call *call) {
 static bool lib_id_imp(struct cx_call *call) {
   struct cx_box *lib = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = lib->as_lib->id;
+  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = cx_intern(s->cx, lib->as_lib->id.id);
   return true;
 }
 
 static bool get_lib_imp(struct cx_call *call) {
   struct cx_box *id = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  struct cx_lib *lib = cx_get_lib(s->cx, id->as_sym.id, true);
+  struct cx_lib *lib = cx_get_lib(s->cx, id->as_sym->id, true);
   
   if (lib) {
+    if (!cx_ensure_lib(lib)) { return false; }
     cx_box_init(cx_push(s), s->cx->lib_type)->as_lib = lib;
   } else {
     cx_box_init(cx_push(s), s->cx->nil_type);
@@ -176,10 +179,30 @@ static bool get_lib_imp(struct cx_call *call) {
   return true;
 }
 
+static bool init_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+  
+  cx_do_set(&cx->lib_lookup, struct cx_lib *, l) {
+    if (!(*l)->init_ns) { continue; }
+    struct cx_pair *p = cx_pair_new(cx, NULL, NULL);
+    cx_box_init(&p->a, cx->sym_type)->as_sym = cx_intern(cx, (*l)->id.id);
+    cx_box_init(&p->b, cx->int_type)->as_int = (*l)->init_ns;
+    
+    cx_box_init(cx_vec_push(&out->imp),
+		cx_type_get(cx->pair_type, cx->sym_type, cx->int_type))->as_pair = p;
+  }
+  
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
 cx_lib(cx_init_meta, "cx/meta") {
   struct cx *cx = lib->cx;
     
-  if (!cx_use(cx, "cx/abc", "Lib", "Opt", "Str", "Sym")) {
+  if (!cx_use(cx, "cx/abc", "Int", "Lib", "Opt", "Stack", "Str", "Sym") ||
+      !cx_use(cx, "cx/pair", "Pair")) {
     return false;
   }
     
@@ -201,5 +224,10 @@ cx_lib(cx_init_meta, "cx/meta") {
 	       cx_args(cx_arg(NULL, cx_type_get(cx->opt_type, cx->lib_type))),
 	       get_lib_imp);
 
+  cx_add_cfunc(lib, "init-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       init_stats_imp);
+
   return true;
 }
@@ -44,7 +44,7 @@ static bool listen_imp(struct cx_call *call) {
   addr.sin_port = htons(port->as_int);
   addr.sin_addr.s_addr = (host->type == s->cx->nil_type)
     ? INADDR_ANY
-    : inet_addr(host->as_str->data);
+    : inet_addr(cx_str_cstr(host->as_str));
   
   if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
     cx_error(s->cx, s->cx->row, s->cx->col, "Failed binding socket: %d", errno);
@@ -100,7 +100,7 @@ static bool connect_imp(struct cx_call *call) {
   struct sockaddr_in addr = {0};
   addr.sin_family = AF_INET;
   addr.sin_port = htons(port->as_int);
-  addr.sin_addr.s_addr = inet_addr(host->as_str->data);
+  addr.sin_addr.s_addr = inet_addr(cx_str_cstr(host->as_str));
 
   if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1 &&
       errno != EINPROGRESS) {
@@ -54,7 +54,7 @@ static bool exec_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   struct cx_stack *args = argsv->as_ptr;
   char *as[args->imp.count+2];
-  as[0] = cmd->as_str->data;
+  as[0] = cx_str_cstr(cmd->as_str);
   as[args->imp.count+1] = NULL;
   char **asp = as+1;
   
@@ -64,10 +64,10 @@ static bool exec_imp(struct cx_call *call) {
       return false;
     }
 
-    *asp++ = a->as_str->data;
+    *asp++ = cx_str_cstr(a->as_str);
   }
 
-  execvp(cmd->as_str->data, as);
+  execvp(cx_str_cstr(cmd->as_str), as);
   cx_error(s->cx, s->cx->row, s->cx->col, "Failed executing command: %d", errno);
   return false;
 }
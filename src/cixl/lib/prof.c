@@ -0,0 +1,65 @@
+#include "cixl/arg.h"
+#include "cixl/call.h"
+#include "cixl/cx.h"
+#include "cixl/error.h"
+#include "cixl/file.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/lib.h"
+#include "cixl/lib/prof.h"
+#include "cixl/prof.h"
+#include "cixl/scope.h"
+
+static bool start_imp(struct cx_call *call) {
+  struct cx *cx = call->scope->cx;
+  return cx_prof_start(&cx->prof, CX_PROF_INTERVAL);
+}
+
+static bool stop_imp(struct cx_call *call) {
+  struct cx *cx = call->scope->cx;
+  return cx_prof_stop(&cx->prof);
+}
+
+static bool dump_imp(struct cx_call *call) {
+  struct cx_box *out = cx_test(cx_call_arg(call, 0));
+  struct cx *cx = call->scope->cx;
+  cx_prof_dump(&cx->prof, cx_file_ptr(out->as_file));
+  return true;
+}
+
+static bool fold_imp(struct cx_call *call) {
+  struct cx_box *out = cx_test(cx_call_arg(call, 0));
+  struct cx *cx = call->scope->cx;
+  cx_prof_fold(&cx->prof, cx_file_ptr(out->as_file));
+  return true;
+}
+
+cx_lib(cx_init_prof, "cx/prof") {
+  struct cx *cx = lib->cx;
+    
+  if (!cx_use(cx, "cx/io", "WFile")) {
+    return false;
+  }
+
+  cx_add_cfunc(lib, "prof-start",
+	       cx_args(),
+	       cx_args(),
+	       start_imp);
+
+  cx_add_cfunc(lib, "prof-stop",
+	       cx_args(),
+	       cx_args(),
+	       stop_imp);
+
+  cx_add_cfunc(lib, "prof-dump",
+	       cx_args(cx_arg("out", cx->wfile_type)),
+	       cx_args(),
+	       dump_imp);
+
+  cx_add_cfunc(lib, "prof-fold",
+	       cx_args(cx_arg("out", cx->wfile_type)),
+	       cx_args(),
+	       fold_imp);
+
+  return true;
+}
@@ -0,0 +1,9 @@
+#ifndef CX_LIB_PROF_H
+#define CX_LIB_PROF_H
+
+struct cx;
+struct cx_lib;
+
+struct cx_lib *cx_init_prof(struct cx *cx);
+
+#endif
@@ -151,8 +151,8 @@ static bool rec_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
 
   cx_do_vec(&parents, struct cx_type *, pt) { cx_derive_rec(rec_type, *pt); }
   struct cx_rmacro_eval *eval = cx_rmacro_eval_new(rec_eval);
-  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), row, col)->as_ptr = rec_type;
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), cx->file, row, col)->as_ptr = rec_type;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   ok = true;
  exit4:
   cx_vec_deinit(&fids);	      
@@ -169,7 +169,7 @@ static bool rec_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
 }
 
 static bool get_imp(struct cx_call *call) {
-  struct cx_sym *f = &cx_test(cx_call_arg(call, 1))->as_sym;
+  struct cx_sym *f = cx_test(cx_call_arg(call, 1))->as_sym;
   struct cx_box *r = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   struct cx_rec_type *rt = cx_baseof(r->type, struct cx_rec_type, imp);
@@ -195,7 +195,7 @@ static bool get_imp(struct cx_call *call) {
 
 static bool put_imp(struct cx_call *call) {
   struct cx_box *v = cx_test(cx_call_arg(call, 2));
-  struct cx_sym *fid = &cx_test(cx_call_arg(call, 1))->as_sym;
+  struct cx_sym *fid = cx_test(cx_call_arg(call, 1))->as_sym;
   struct cx_box *r = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
@@ -224,7 +224,7 @@ static bool put_imp(struct cx_call *call) {
 
 static bool put_call_imp(struct cx_call *call) {
   struct cx_box *act = cx_test(cx_call_arg(call, 2));
-  struct cx_sym *fid = &cx_test(cx_call_arg(call, 1))->as_sym;
+  struct cx_sym *fid = cx_test(cx_call_arg(call, 1))->as_sym;
   struct cx_box *r = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   struct cx_rec_type *rt = cx_baseof(r->type, struct cx_rec_type, imp);
@@ -285,7 +285,7 @@ static bool into_imp(struct cx_call *call) {
       goto exit;
     }
 
-    struct cx_sym *fid = &p.as_pair->a.as_sym;
+    struct cx_sym *fid = p.as_pair->a.as_sym;
     struct cx_field *f = cx_set_get(&rt->fields, fid);
     
     if (!f) {
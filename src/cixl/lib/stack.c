@@ -238,9 +238,9 @@ static bool sort_imp(struct cx_call *call) {
 	return 0;
       }
       
-      if (out->as_sym.tag == lt.tag) {
+      if (out->as_sym->tag == lt.tag) {
 	res = -1;
-      } else if (out->as_sym.tag == gt.tag) {
+      } else if (out->as_sym->tag == gt.tag) {
 	res = 1;
       }
     }
@@ -22,13 +22,69 @@ typedef bool (*cx_split_t)(unsigned char c);
 struct cx_split_iter {
   struct cx_iter iter;
   struct cx_iter *in;
+  struct cx_str *str;
+  size_t pos;
   cx_split_t split_fn;
   struct cx_box split;
   struct cx_mfile out;
 };
 
+static bool is_split(struct cx_split_iter *it,
+		     struct cx_box *c,
+		     struct cx_scope *scope,
+		     bool *out) {
+  struct cx *cx = scope->cx;
+  
+  if (it->split_fn) {
+    *out = it->split_fn(c->as_char);
+  } else if (it->split.type == cx->char_type) {
+    *out = c->as_char == it->split.as_char;
+  } else {
+    *cx_push(scope) = *c;
+    if (!cx_call(&it->split, scope)) { return false; }
+    struct cx_box *res = cx_pop(scope, true);
+    
+    if (!res) {
+      cx_error(cx, cx->row, cx->col, "Missing split result");
+      return false;
+    }
+    
+    *out = res->as_bool;
+  }
+
+  return true;
+}
+
+static bool split_str_next(struct cx_split_iter *it,
+			   struct cx_box *out,
+			   struct cx_scope *scope) {
+  struct cx_str *s = it->str;
+  size_t start = it->pos, end = start;
+  
+  while (it->pos < s->len) {
+    struct cx_box c;
+    cx_box_init(&c, scope->cx->char_type)->as_char = s->data[it->pos++];
+    bool split = false;
+    if (!is_split(it, &c, scope, &split)) { return false; }
+    
+    if (!split) {
+      end = it->pos;
+    } else if (end > start) {
+      break;
+    } else {
+      start = end = it->pos;
+    }
+  }
+
+  if (it->pos == s->len) { it->iter.done = true; }
+  if (end == start) { return false; }
+  cx_box_init(out, scope->cx->str_type)->as_str = cx_str_slice(scope->cx, s, start, end-start);
+  return true;
+}
+
 bool split_next(struct cx_iter *iter, struct cx_box *out, struct cx_scope *scope) {
   struct cx_split_iter *it = cx_baseof(iter, struct cx_split_iter, iter);
+  if (it->str) { return split_str_next(it, out, scope); }
   struct cx *cx = scope->cx;
   struct cx_box c;
   bool ok = false;
@@ -42,25 +98,7 @@ bool split_next(struct cx_iter *iter, struct cx_box *out, struct cx_scope *scope
     }
 
     bool split = false;
-    
-    if (it->split_fn) {
-      split = it->split_fn(c.as_char);
-    } else {
-      if (it->split.type == cx->char_type) {
-	split = c.as_char == it->split.as_char;
-      } else {
-	*cx_push(scope) = c;
-	if (!cx_call(&it->split, scope)) { goto exit; }
-	struct cx_box *res = cx_pop(scope, true);
-	
-	if (!res) {
-	  cx_error(cx, cx->row, cx->col, "Missing split result");
-	  goto exit;
-	}
-	
-	split = res->as_bool;
-      }
-    } 
+    if (!is_split(it, &c, scope, &split)) { goto exit; }
     
     if (split) {
       fflush(it->out.stream);
@@ -70,7 +108,7 @@ bool split_next(struct cx_iter *iter, struct cx_box *out, struct cx_scope *scope
     }
   }
 
-  cx_box_init(out, cx->str_type)->as_str = cx_str_new(it->out.data, it->out.size);
+  cx_box_init(out, cx->str_type)->as_str = cx_str_new(cx, it->out.data, it->out.size);
   ok = true;
  exit:
   cx_mfile_close(&it->out);
@@ -81,11 +119,16 @@ bool split_next(struct cx_iter *iter, struct cx_box *out, struct cx_scope *scope
 
 void *split_deinit(struct cx_iter *iter) {
   struct cx_split_iter *it = cx_baseof(iter, struct cx_split_iter, iter);
-  cx_iter_deref(it->in);
 
-  if (it->out.stream) {
-    cx_mfile_close(&it->out);
-    free(it->out.data);
+  if (it->str) {
+    cx_str_deref(it->str);
+  } else {
+    cx_iter_deref(it->in);
+    
+    if (it->out.stream) {
+      cx_mfile_close(&it->out);
+      free(it->out.data);
+    }
   }
   
   if (!it->split_fn) { cx_box_deinit(&it->split); }
@@ -101,11 +144,37 @@ struct cx_split_iter *cx_split_iter_new(struct cx_iter *in) {
   struct cx_split_iter *it = malloc(sizeof(struct cx_split_iter));
   cx_iter_init(&it->iter, split_iter());
   it->in = in;
+  it->str = NULL;
   cx_mfile_open(&it->out);
   it->split_fn = NULL;
   return it;
 }
 
+// Strings are split into slices of a private parent, shared input is
+// copied once to keep later mutation from showing through.
+
+static struct cx_split_iter *split_iter_new(struct cx_box *in) {
+  struct cx *cx = in->type->lib->cx;
+  
+  if (in->type != cx->str_type) {
+    struct cx_box it;
+    cx_iter(in, &it);
+    return cx_split_iter_new(it.as_iter);
+  }
+
+  struct cx_split_iter *it = malloc(sizeof(struct cx_split_iter));
+  cx_iter_init(&it->iter, split_iter());
+  it->in = NULL;
+  struct cx_str *s = in->as_str;
+  
+  it->str = (s->nrefs == 1) ? cx_str_ref(s) : cx_str_new(cx, s->data, s->len);
+  
+  it->pos = 0;
+  it->out.stream = NULL;
+  it->split_fn = NULL;
+  return it;
+}
+
 struct hex_coder {
   struct cx_iter iter;
   struct cx_iter *in;
@@ -206,10 +275,9 @@ static struct cx_iter *hex_decoder_new(struct cx_iter *in) {
 bool split_lines(unsigned char c) { return c == '\r' || c == '\n'; }
 
 static bool lines_imp(struct cx_call *call) {
-  struct cx_box *in = cx_test(cx_call_arg(call, 0)), in_it;
+  struct cx_box *in = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_iter(in, &in_it);
-  struct cx_split_iter *it = cx_split_iter_new(in_it.as_iter);
+  struct cx_split_iter *it = split_iter_new(in);
   it->split_fn = split_lines;
   cx_box_init(cx_push(s), s->cx->iter_type)->as_iter = &it->iter;
   return true;
@@ -220,10 +288,9 @@ bool split_words(unsigned char c) {
 }
 
 static bool words_imp(struct cx_call *call) {
-  struct cx_box *in = cx_test(cx_call_arg(call, 0)), in_it;
+  struct cx_box *in = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_iter(in, &in_it);
-  struct cx_split_iter *it = cx_split_iter_new(in_it.as_iter);
+  struct cx_split_iter *it = split_iter_new(in);
   it->split_fn = split_words;
   cx_box_init(cx_push(s), s->cx->iter_type)->as_iter = &it->iter;
   return true;
@@ -232,12 +299,10 @@ static bool words_imp(struct cx_call *call) {
 static bool split_imp(struct cx_call *call) {
   struct cx_box
     *split = cx_test(cx_call_arg(call, 1)),
-    *in = cx_test(cx_call_arg(call, 0)),
-    in_it;
+    *in = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
-  cx_iter(in, &in_it);
-  struct cx_split_iter *it = cx_split_iter_new(in_it.as_iter);
+  struct cx_split_iter *it = split_iter_new(in);
   cx_copy(&it->split, split);
   cx_box_init(cx_push(s), s->cx->iter_type)->as_iter = &it->iter;
   return true;
@@ -288,7 +353,7 @@ static bool int_str_imp(struct cx_call *call) {
   struct cx_box *v = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   char *sv = cx_fmt("%" PRId64, v->as_int);
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(sv, strlen(sv));
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, sv, strlen(sv));
   free(sv);
   return true;
 }
@@ -346,7 +411,7 @@ static bool repeat_imp(struct cx_call *call) {
   
   struct cx_mfile out;
   cx_mfile_open(&out);
-  fputs(v->as_str->data, out.stream);
+  fputs(cx_str_cstr(v->as_str), out.stream);
   bool ok = false;
   
   for (int64_t i=0; i<n->as_int; i++) {
@@ -363,7 +428,7 @@ static bool repeat_imp(struct cx_call *call) {
 
   fflush(out.stream);
   cx_box_init(cx_push(s), s->cx->str_type)->as_str =
-    cx_str_new(out.data, ftell(out.stream));
+    cx_str_new(s->cx, out.data, ftell(out.stream));
   ok = true;
  exit:
   cx_mfile_close(&out);
@@ -378,7 +443,7 @@ static bool pop_imp(struct cx_call *call) {
   if (v->len) {
     cx_box_init(cx_push(s), s->cx->char_type)->as_char = v->data[v->len-1];
     v->len--;
-    v->data[v->len] = 0;
+    if (!v->parent) { v->data[v->len] = 0; }
   } else {
     cx_box_init(cx_push(s), s->cx->nil_type);
   }
@@ -401,7 +466,7 @@ static bool seq_imp(struct cx_call *call) {
   
   fflush(out.stream);
   cx_box_init(cx_push(s), s->cx->str_type)->as_str =
-    cx_str_new(out.data, ftell(out.stream));
+    cx_str_new(s->cx, out.data, ftell(out.stream));
   cx_mfile_close(&out);
   free(out.data);
   cx_box_deinit(&it);
@@ -411,7 +476,7 @@ static bool seq_imp(struct cx_call *call) {
 static bool str_int_imp(struct cx_call *call) {
   struct cx_str *v = cx_test(cx_call_arg(call, 0))->as_str;
   struct cx_scope *s = call->scope;
-  int64_t iv = strtoimax(v->data, NULL, 10);
+  int64_t iv = strtoimax(cx_str_cstr(v), NULL, 10);
   
   if (!iv && v->data[0] != '0') {
     cx_box_init(cx_push(s), s->cx->nil_type);
@@ -430,27 +495,29 @@ static bool str_sub_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   
   cx_box_init(cx_push(s),
-	      s->cx->int_type)->as_int = cx_str_dist(x->as_str->data,
-						     y->as_str->data);
+	      s->cx->int_type)->as_int = cx_str_dist(cx_str_cstr(x->as_str),
+						     cx_str_cstr(y->as_str));
   
   return true;
 }
 
 static bool str_upper_imp(struct cx_call *call) {
   struct cx_str *v = cx_test(cx_call_arg(call, 0))->as_str;
+  cx_str_cstr(v);
   for (char *c = v->data; c < v->data+v->len; c++) { *c = toupper(*c); }
   return true;
 }
 
 static bool str_lower_imp(struct cx_call *call) {
   struct cx_str *v = cx_test(cx_call_arg(call, 0))->as_str;
+  cx_str_cstr(v);
   for (char *c = v->data; c < v->data+v->len; c++) { *c = tolower(*c); }
   return true;
 }
 
 static bool str_reverse_imp(struct cx_call *call) {
   struct cx_box *v = cx_test(cx_call_arg(call, 0));
-  cx_reverse(v->as_str->data, v->as_str->len);
+  cx_reverse(cx_str_cstr(v->as_str), v->as_str->len);
   return true;
 }
 
@@ -476,7 +543,7 @@ static bool join_imp(struct cx_call *call) {
 
   cx_box_deinit(&it);
   cx_mfile_close(&out);
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(out.data, out.size);
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, out.data, out.size);
   free(out.data);
   return true;
 }
@@ -15,14 +15,14 @@
 static bool sym_imp(struct cx_call *call) {
   struct cx_box *v = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = cx_sym(s->cx, v->as_str->data);
+  cx_box_init(cx_push(s), s->cx->sym_type)->as_sym = cx_intern(s->cx, cx_str_cstr(v->as_str));
   return true;
 }
 
 static bool str_imp(struct cx_call *call) {
-  struct cx_sym *v = &cx_test(cx_call_arg(call, 0))->as_sym;
+  struct cx_sym *v = cx_test(cx_call_arg(call, 0))->as_sym;
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(v->id, strlen(v->id));
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, v->id, strlen(v->id));
   return true;
 }
 
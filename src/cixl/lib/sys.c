@@ -14,9 +14,11 @@
 #include "cixl/lib/sys.h"
 #include "cixl/link.h"
 #include "cixl/op.h"
+#include "cixl/pair.h"
 #include "cixl/scope.h"
 #include "cixl/str.h"
 #include "cixl/stack.h"
+#include "cixl/stats.h"
 
 static bool link_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   int row = cx->row, col = cx->col;
@@ -105,24 +107,60 @@ static bool init_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   }
 }
 
+static bool arena_imp(struct cx_call *call) {
+  struct cx_box *v = cx_test(cx_call_arg(call, 0));
+  struct cx_scope *s = call->scope;
+  cx_push_arena(s->cx);
+  bool ok = cx_call(v, s);
+  cx_pop_arena(s->cx);
+  return ok;
+}
+
+static bool pool_stats_imp(struct cx_call *call) {
+  struct cx_scope *s = call->scope;
+  struct cx *cx = s->cx;
+  struct cx_stack *out = cx_stack_new(cx);
+  struct cx_malloc *a = NULL;
+  const char *id = NULL;
+  
+  for (size_t i = 0; (a = cx_get_alloc(cx, i, &id)); i++) {
+    struct cx_stack *as = cx_stack_new(cx);
+    cx_push_stat(as, "live", a->nlive, cx);
+    cx_push_stat(as, "max-live", a->max_live, cx);
+    cx_push_stat(as, "slabs", a->nslabs, cx);
+    cx_push_stat(as, "free", a->nslots - a->nlive, cx);
+    cx_push_stat(as, "bytes", cx_malloc_bytes(a), cx);
+
+    struct cx_pair *p = cx_pair_new(cx, NULL, NULL);
+    cx_box_init(&p->a, cx->sym_type)->as_sym = cx_intern(cx, id);
+    cx_box_init(&p->b, cx->stack_type)->as_ptr = as;
+    
+    struct cx_type *t = cx_type_get(cx->pair_type, cx->sym_type, cx->stack_type);
+    cx_box_init(cx_vec_push(&out->imp), t)->as_pair = p;
+  }
+  
+  cx_box_init(cx_push(s), cx->stack_type)->as_ptr = out;
+  return true;
+}
+
 static bool home_dir_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   const char *d = cx_home_dir();
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(d, strlen(d));
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, d, strlen(d));
   return true;
 }
 
 static bool make_dir_imp(struct cx_call *call) {
   struct cx_box *p = cx_test(cx_call_arg(call, 0));
-  return cx_make_dir(p->as_str->data);
+  return cx_make_dir(cx_str_cstr(p->as_str));
 }
 
 static bool sleep_imp(struct cx_call *call) {
   struct cx_box *ns = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   struct timespec req = {0}, rem = {0};
-  req.tv_sec = ns->as_time.ns / CX_SEC;
-  req.tv_nsec = ns->as_time.ns % CX_SEC;
+  req.tv_sec = ns->as_time->ns / CX_SEC;
+  req.tv_nsec = ns->as_time->ns % CX_SEC;
 
   if (nanosleep(&req, &rem) == -1) {
     if (errno != EINTR) {
@@ -130,8 +168,8 @@ static bool sleep_imp(struct cx_call *call) {
       return false;
     }
     
-    struct cx_time *t = &cx_box_init(cx_push(s), s->cx->time_type)->as_time;
-    cx_time_init(t, 0, rem.tv_sec*CX_SEC + rem.tv_nsec);  
+    cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+      cx_time_new(s->cx, 0, rem.tv_sec*CX_SEC + rem.tv_nsec);
   } else {
     cx_box_init(cx_push(s), s->cx->nil_type);
   }
@@ -154,6 +192,11 @@ cx_lib(cx_init_sys, "cx/sys") {
   cx_add_rmacro(lib, "link:", link_parse);
   cx_add_rmacro(lib, "init:", init_parse);
 
+  cx_add_cfunc(lib, "arena",
+	       cx_args(cx_arg("act", cx->any_type)),
+	       cx_args(),
+	       arena_imp);
+
   cx_add_cfunc(lib, "home-dir",
 	       cx_args(),
 	       cx_args(cx_arg(NULL, cx->str_type)),
@@ -164,6 +207,11 @@ cx_lib(cx_init_sys, "cx/sys") {
 	       cx_args(),
 	       make_dir_imp);
 
+  cx_add_cfunc(lib, "pool-stats",
+	       cx_args(),
+	       cx_args(cx_arg(NULL, cx_type_get(cx->stack_type, cx->pair_type))),
+	       pool_stats_imp);
+
   cx_add_cfunc(lib, "sleep",
 	       cx_args(cx_arg("t", cx->time_type)),
 	       cx_args(cx_arg(NULL, cx_type_get(cx->opt_type, cx->time_type))),
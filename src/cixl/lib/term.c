@@ -19,11 +19,11 @@
 static bool ask_imp(struct cx_call *call) {
   struct cx_box *p = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  fputs(p->as_str->data, stdout);
+  fputs(cx_str_cstr(p->as_str), stdout);
   char *line = NULL;
   size_t len = 0;
   if (!cx_get_line(&line, &len, stdin)) { return false; }
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(line, strlen(line));
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, line, strlen(line));
   free(line);
   return true;
 }
@@ -190,7 +190,7 @@ static bool move_right_imp(struct cx_call *call) {
 
 static bool move_to_imp(struct cx_call *call) {
   FILE *out = cx_file_ptr(cx_test(cx_call_arg(call, 0))->as_file);
-  struct cx_point *pos = &cx_test(cx_call_arg(call, 1))->as_point;
+  struct cx_point *pos = cx_test(cx_call_arg(call, 1))->as_point;
   fprintf(out,
 	  CX_CSI_ESC "%" PRId64 ";%" PRId64 "H",
 	  (int64_t)pos->y, (int64_t)pos->x);
@@ -39,8 +39,8 @@ static bool years_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       n->as_int*12, 0);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, n->as_int*12, 0);
 
   return true;
 }
@@ -49,8 +49,8 @@ static bool months_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       n->as_int, 0);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, n->as_int, 0);
 
   return true;
 }
@@ -59,8 +59,8 @@ static bool days_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_DAY);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_DAY);
 
   return true;
 }
@@ -69,8 +69,8 @@ static bool h_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_HOUR);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_HOUR);
   
   return true;
 }
@@ -79,8 +79,8 @@ static bool m_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_MIN);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_MIN);
 
   return true;
 }
@@ -89,8 +89,8 @@ static bool s_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_SEC);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_SEC);
 
   return true;
 }
@@ -99,8 +99,8 @@ static bool ms_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_MSEC);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_MSEC);
 
   return true;
 }
@@ -109,8 +109,8 @@ static bool us_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int*CX_USEC);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int*CX_USEC);
 
   return true;
 }
@@ -119,8 +119,8 @@ static bool ns_imp(struct cx_call *call) {
   struct cx_box *n = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
   
-  cx_time_init(&cx_box_init(cx_push(s), s->cx->time_type)->as_time,
-	       0, n->as_int);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, 0, n->as_int);
   
   return true;
 }
@@ -159,7 +159,8 @@ static bool stack_time_imp(struct cx_call *call) {
     }
   }
 
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
@@ -173,66 +174,67 @@ static bool now_imp(struct cx_call *call) {
     cx_error(s->cx, s->cx->row, s->cx->col, "Failed destructuring time: %d", errno);
   }
   
-  struct cx_time *t = &cx_box_init(cx_push(s), s->cx->time_type)->as_time;
-
-  cx_time_init(t,
-	       (tm.tm_year+1900)*12 + tm.tm_mon,
-	       (tm.tm_mday-1) * CX_DAY +
-	       (tm.tm_hour) * CX_HOUR +
-	       (tm.tm_min) * CX_MIN +
-	       (tm.tm_sec) * CX_SEC +
-	       ts.tv_nsec);
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx,
+		(tm.tm_year+1900)*12 + tm.tm_mon,
+		(tm.tm_mday-1) * CX_DAY +
+		(tm.tm_hour) * CX_HOUR +
+		(tm.tm_min) * CX_MIN +
+		(tm.tm_sec) * CX_SEC +
+		ts.tv_nsec);
   
   return true;
 }
 
 static bool time_date_imp(struct cx_call *call) {
-  struct cx_time t = cx_test(cx_call_arg(call, 0))->as_time;
+  struct cx_time t = *cx_test(cx_call_arg(call, 0))->as_time;
   struct cx_scope *s = call->scope;
   t.ns /= CX_DAY;
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
 static bool time_time_imp(struct cx_call *call) {
-  struct cx_time t = cx_test(cx_call_arg(call, 0))->as_time;
+  struct cx_time t = *cx_test(cx_call_arg(call, 0))->as_time;
   struct cx_scope *s = call->scope;
   t.months = 0;
   t.ns %= CX_DAY;
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;  
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
 static bool time_years_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.months / 12;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->months / 12;
   return true;
 }
 
 static bool month_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.months % 12;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->months % 12;
   return true;
 }
 
 static bool time_months_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.months;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->months;
   return true;
 }
 
 static bool time_day_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_DAY;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_DAY;
   return true;
 }
 
 static bool time_days_imp(struct cx_call *call) {
-  struct cx_time *t = &cx_test(cx_call_arg(call, 0))->as_time;
+  struct cx_time *t = cx_test(cx_call_arg(call, 0))->as_time;
   struct cx_scope *s = call->scope;
   int y_max = cx_abs(t->months/12), m_max = cx_abs(t->months%12);
   int64_t days = 0;
@@ -259,7 +261,7 @@ static bool hour_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   
   cx_box_init(cx_push(s),
-	      s->cx->int_type)->as_int = (t->as_time.ns % CX_DAY) / CX_HOUR;
+	      s->cx->int_type)->as_int = (t->as_time->ns % CX_DAY) / CX_HOUR;
   
   return true;
 }
@@ -269,7 +271,7 @@ static bool minute_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   
   cx_box_init(cx_push(s), s->cx->int_type)->as_int =
-    (t->as_time.ns % CX_HOUR) / CX_MIN;
+    (t->as_time->ns % CX_HOUR) / CX_MIN;
 
   return true;
 }
@@ -279,7 +281,7 @@ static bool second_imp(struct cx_call *call) {
   struct cx_scope *s = call->scope;
   
   cx_box_init(cx_push(s), s->cx->int_type)->as_int =
-    (t->as_time.ns % CX_MIN) / CX_SEC;
+    (t->as_time->ns % CX_MIN) / CX_SEC;
   
   return true;
 }
@@ -287,49 +289,49 @@ static bool second_imp(struct cx_call *call) {
 static bool nsecond_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = (t->as_time.ns % CX_SEC);
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = (t->as_time->ns % CX_SEC);
   return true;
 }
 
 static bool time_h_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_HOUR;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_HOUR;
   return true;
 }
 
 static bool time_m_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_MIN;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_MIN;
   return true;
 }
 
 static bool time_s_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_SEC;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_SEC;
   return true;
 }
 
 static bool time_ms_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_MSEC;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_MSEC;
   return true;
 }
 
 static bool time_us_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns / CX_USEC;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns / CX_USEC;
   return true;
 }
 
 static bool time_ns_imp(struct cx_call *call) {
   struct cx_box *t = cx_test(cx_call_arg(call, 0));
   struct cx_scope *s = call->scope;
-  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time.ns;
+  cx_box_init(cx_push(s), s->cx->int_type)->as_int = t->as_time->ns;
   return true;
 }
 
@@ -339,10 +341,11 @@ static bool add_imp(struct cx_call *call) {
     *x = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
-  struct cx_time t = x->as_time;
-  t.months += y->as_time.months;
-  t.ns += y->as_time.ns;
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;
+  struct cx_time t = *x->as_time;
+  t.months += y->as_time->months;
+  t.ns += y->as_time->ns;
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
@@ -352,10 +355,11 @@ static bool sub_imp(struct cx_call *call) {
     *x = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
-  struct cx_time t = x->as_time;
-  t.months -= y->as_time.months;
-  t.ns -= y->as_time.ns;
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;
+  struct cx_time t = *x->as_time;
+  t.months -= y->as_time->months;
+  t.ns -= y->as_time->ns;
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
@@ -365,10 +369,11 @@ static bool mul_imp(struct cx_call *call) {
     *x = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
-  struct cx_time t = x->as_time;
+  struct cx_time t = *x->as_time;
   t.months *= y->as_int;
   t.ns *= y->as_int;
-  cx_box_init(cx_push(s), s->cx->time_type)->as_time = t;
+  cx_box_init(cx_push(s), s->cx->time_type)->as_time =
+    cx_time_new(s->cx, t.months, t.ns);
   return true;
 }
 
@@ -389,8 +394,8 @@ static bool fmt_imp(struct cx_call *call) {
     *t = cx_test(cx_call_arg(call, 0));
 
   struct cx_scope *s = call->scope;
-  char *ts = cx_time_fmt(&t->as_time, f->as_str->data);
-  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(ts, strlen(ts));
+  char *ts = cx_time_fmt(t->as_time, cx_str_cstr(f->as_str));
+  cx_box_init(cx_push(s), s->cx->str_type)->as_str = cx_str_new(s->cx, ts, strlen(ts));
   free(ts);
   return true;
 }
@@ -404,17 +409,14 @@ cx_lib(cx_init_time, "cx/time") {
 
   cx->time_type = cx_init_time_type(lib);
     
-  cx_time_init(&cx_box_init(cx_put_const(lib, cx_sym(cx, "min-time"), false),
-			    cx->time_type)->as_time,
-	       INT32_MIN, INT64_MIN);
+  cx_box_init(cx_put_const(lib, cx_sym(cx, "min-time"), false),
+	      cx->time_type)->as_time = cx_time_new(cx, INT32_MIN, INT64_MIN);
   
-  cx_time_init(&cx_box_init(cx_put_const(lib, cx_sym(cx, "max-time"), false),
-			    cx->time_type)->as_time,
-	       INT32_MAX, INT64_MAX);
+  cx_box_init(cx_put_const(lib, cx_sym(cx, "max-time"), false),
+	      cx->time_type)->as_time = cx_time_new(cx, INT32_MAX, INT64_MAX);
   
-  cx_time_init(&cx_box_init(cx_put_const(lib, cx_sym(cx, "nil-time"), false),
-			    cx->time_type)->as_time,
-	       0, 0);
+  cx_box_init(cx_put_const(lib, cx_sym(cx, "nil-time"), false),
+	      cx->time_type)->as_time = cx_time_new(cx, 0, 0);
 
   cx_add_cfunc(lib, "years",
 	       cx_args(cx_arg("n", cx->int_type)),
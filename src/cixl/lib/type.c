@@ -100,8 +100,8 @@ static bool type_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   }
 
   struct cx_rmacro_eval *eval = cx_rmacro_eval_new(type_set_eval);
-  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), row, col)->as_ptr = type;
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), cx->file, row, col)->as_ptr = type;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   ok = true;
  exit1:
   cx_tok_deinit(&id_tok);
@@ -244,8 +244,8 @@ static bool type_id_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
   }
 
   struct cx_rmacro_eval *eval = cx_rmacro_eval_new(type_set_eval);
-  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), row, col)->as_ptr = type;
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(&eval->toks), CX_TTYPE(), cx->file, row, col)->as_ptr = type;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   ok = true;
  exit3:
   cx_vec_deinit(&parents);
@@ -29,6 +29,7 @@ static ssize_t let_eval(struct cx_rmacro_eval *eval,
     struct cx_op * op = cx_op_new(bin, CX_OPUTVAR(), tok_idx);
     op->as_putvar.id = cx_sym(cx, id);
     op->as_putvar.type = type;
+    op->as_putvar.slot = -1;
   }
 
   struct cx_tok *id_tok = cx_vec_get(&eval->toks, 0);
@@ -108,7 +109,7 @@ static bool let_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
     goto error;
   }
   
-  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), row, col)->as_ptr = eval;
+  cx_tok_init(cx_vec_push(out), CX_TRMACRO(), cx->file, row, col)->as_ptr = eval;
   return true;
  error:
   cx_rmacro_eval_deref(eval);
@@ -117,7 +118,7 @@ static bool let_parse(struct cx *cx, FILE *in, struct cx_vec *out) {
 
 static bool let_imp(struct cx_call *call) {
   struct cx_box *v = cx_test(cx_call_arg(call, 1));
-  struct cx_sym id = cx_test(cx_call_arg(call, 0))->as_sym;
+  struct cx_sym id = *cx_test(cx_call_arg(call, 0))->as_sym;
   struct cx_scope *s = call->scope;
   struct cx_box *var = cx_put_var(s, id);
   cx_copy(var, v);
@@ -125,7 +126,7 @@ static bool let_imp(struct cx_call *call) {
 }
 
 static bool var_imp(struct cx_call *call) {
-  struct cx_sym id = cx_test(cx_call_arg(call, 0))->as_sym;
+  struct cx_sym id = *cx_test(cx_call_arg(call, 0))->as_sym;
   struct cx_scope *s = call->scope;
   struct cx_box *v = cx_get_var(s, id, true);
 
@@ -1,31 +1,81 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "cixl/error.h"
 #include "cixl/malloc.h"
 #include "cixl/util.h"
 
+// Arena slabs count their live slots and are released as soon as they are
+// drained, a survivor only keeps its own slab alive.
+
 struct cx_malloc_slab {
-  size_t used_slots;
-  struct cx_malloc_slab *next;
+  struct cx_malloc_arena *arena;
+  size_t used_slots, nlive;
+  struct cx_malloc_slab *prev, *next;
   char slots[];
 };
 
+// Allocated arena slots remember their slab, other allocated slots NULL.
+
 struct cx_malloc_slot {
-  struct cx_malloc_slot *next;
+  union {
+    struct cx_malloc_slot *next;
+    struct cx_malloc_slab *slab;
+  };
+  
   char ptr[];
 };
 
-static struct cx_malloc_slab *new_slab(struct cx_malloc *alloc) {
+struct cx_malloc_arena {
+  struct cx_malloc *alloc;
+  struct cx_malloc_slab *root;
+  size_t nlive;
+  bool done;
+  struct cx_malloc_arena *prev;
+};
+
+static struct cx_malloc_slab *new_slab(struct cx_malloc *alloc,
+				       struct cx_malloc_slab **root) {
   struct cx_malloc_slab *slab = malloc(sizeof(struct cx_malloc_slab) +
 				       alloc->slab_size *
 				       (sizeof(struct cx_malloc_slot) +
 					alloc->slot_size));
-  slab->used_slots = 0;
-  slab->next = alloc->root;
-  alloc->root = slab;
+  slab->arena = NULL;
+  slab->used_slots = slab->nlive = 0;
+  slab->prev = NULL;
+  slab->next = *root;
+  if (*root) { (*root)->prev = slab; }
+  *root = slab;
+  alloc->nslabs++;
   return slab;
 }
 
+static void free_slabs(struct cx_malloc_slab *root) {
+  for (struct cx_malloc_slab *s = root, *ns = NULL; s; s = ns) {
+    ns = s->next;
+    free(s);
+  }
+}
+
+static void free_arena_slab(struct cx_malloc_arena *a,
+			    struct cx_malloc_slab *s) {
+  if (s->prev) {
+    s->prev->next = s->next;
+  } else {
+    a->root = s->next;
+  }
+  
+  if (s->next) { s->next->prev = s->prev; }
+  a->alloc->nslabs--;
+  a->alloc->nslots -= s->used_slots;
+  free(s);
+}
+
+static void free_arena(struct cx_malloc_arena *a) {
+  while (a->root) { free_arena_slab(a, a->root); }
+  free(a);
+}
+
 struct cx_malloc *cx_malloc_init(struct cx_malloc *alloc,
 				 size_t slab_size,
 				 size_t slot_size) {
@@ -33,39 +83,133 @@ struct cx_malloc *cx_malloc_init(struct cx_malloc *alloc,
   alloc->slot_size = slot_size;
   alloc->root = NULL;
   alloc->free = NULL;
+  alloc->arena = alloc->retired = NULL;
+  alloc->nslabs = alloc->nslots = alloc->nlive = alloc->max_live = 0;
   return alloc;
 }
 
 struct cx_malloc *cx_malloc_deinit(struct cx_malloc *alloc) {
-  for (struct cx_malloc_slab *s = alloc->root, *ns = NULL; s; s = ns) {
-    ns = s->next;
-    free(s);
+  while (alloc->arena) { cx_malloc_pop_arena(alloc); }
+  
+  for (struct cx_malloc_arena *a = alloc->retired, *na = NULL; a; a = na) {
+    na = a->prev;
+    free_arena(a);
   }
 
+  free_slabs(alloc->root);
   return alloc;
 }
 
+static struct cx_malloc_slot *bump(struct cx_malloc *alloc,
+				   struct cx_malloc_slab **root) {
+  struct cx_malloc_slab *s = *root;
+  if (!s || s->used_slots == alloc->slab_size) { s = new_slab(alloc, root); }
+  
+  struct cx_malloc_slot *slot = (struct cx_malloc_slot *)
+    (s->slots +
+     s->used_slots * (sizeof(struct cx_malloc_slot)+alloc->slot_size));
+
+  s->used_slots++;
+  alloc->nslots++;
+  slot->slab = s;
+  return slot;
+}
+
+// Arenas never reuse single slots, allocations bump through their slabs.
+
+static void *arena_malloc(struct cx_malloc_arena *a) {
+  struct cx_malloc_slot *s = bump(a->alloc, &a->root);
+  s->slab->arena = a;
+  s->slab->nlive++;
+  a->nlive++;
+  return s->ptr;
+}
+
 void *cx_malloc(struct cx_malloc *alloc) {
-  if (alloc->free) {
-    struct cx_malloc_slot *s = alloc->free;
+  alloc->nlive++;
+  if (alloc->nlive > alloc->max_live) { alloc->max_live = alloc->nlive; }
+  if (alloc->arena) { return arena_malloc(alloc->arena); }
+  struct cx_malloc_slot *s = alloc->free;
+  
+  if (s) {
     alloc->free = s->next;
-    return s->ptr;
+  } else {
+    s = bump(alloc, &alloc->root);
   }
+
+  s->slab = NULL;
+  return s->ptr;
+}
+
+static void arena_free(struct cx_malloc_slab *s) {
+  struct cx_malloc_arena *a = s->arena;
+  a->nlive--;
+  if (--s->nlive) { return; }
   
-  struct cx_malloc_slab *s = alloc->root;
-  if (!s || s->used_slots == alloc->slab_size) { s = new_slab(alloc); }
-  
-  void *ptr =
-    s->slots +
-    s->used_slots * (sizeof(struct cx_malloc_slot)+alloc->slot_size) +
-    sizeof(struct cx_malloc_slot);
+  if (!a->done && s == a->root) {
+    // The active slab starts over rather than being released
+    
+    a->alloc->nslots -= s->used_slots;
+    s->used_slots = 0;
+    return;
+  }
 
-  s->used_slots++;
-  return ptr;
+  free_arena_slab(a, s);
+
+  if (a->done && !a->nlive) {
+    struct cx_malloc_arena **p = &a->alloc->retired;
+    while (*p != a) { p = &(*p)->prev; }
+    *p = a->prev;
+    free(a);
+  }
 }
 
 void cx_free(struct cx_malloc *alloc, void *ptr) {
   struct cx_malloc_slot *s = cx_baseof(ptr, struct cx_malloc_slot, ptr);
-  s->next = alloc->free;
-  alloc->free = s;
+  alloc->nlive--;
+  
+  if (s->slab) {
+    arena_free(s->slab);
+  } else {
+    s->next = alloc->free;
+    alloc->free = s;
+  }
+}
+
+size_t cx_malloc_bytes(struct cx_malloc *alloc) {
+  return alloc->nslabs * (sizeof(struct cx_malloc_slab) +
+			  alloc->slab_size *
+			  (sizeof(struct cx_malloc_slot) + alloc->slot_size));
+}
+
+void cx_malloc_push_arena(struct cx_malloc *alloc) {
+  struct cx_malloc_arena *a = malloc(sizeof(struct cx_malloc_arena));
+  a->alloc = alloc;
+  a->root = NULL;
+  a->nlive = 0;
+  a->done = false;
+  a->prev = alloc->arena;
+  alloc->arena = a;
+}
+
+bool cx_malloc_pop_arena(struct cx_malloc *alloc) {
+  struct cx_malloc_arena *a = cx_test(alloc->arena);
+  alloc->arena = a->prev;
+
+  for (struct cx_malloc_slab *s = a->root, *ns = NULL; s; s = ns) {
+    ns = s->next;
+    if (!s->nlive) { free_arena_slab(a, s); }
+  }
+  
+  if (!a->nlive) {
+    free(a);
+    return true;
+  }
+
+  // Slabs holding survivors are released when their last slot is freed
+  
+  a->done = true;
+  a->prev = alloc->retired;
+  alloc->retired = a;
+  return false;
 }
@@ -1,14 +1,18 @@
 #ifndef CIXL_MALLOC_H
 #define CIXL_MALLOC_H
 
+#include <stdbool.h>
 #include <stddef.h>
 
+struct cx_malloc_arena;
 struct cx_malloc_slab;
 
 struct cx_malloc {
   size_t slab_size, slot_size;
   struct cx_malloc_slab *root;
   struct cx_malloc_slot *free;
+  struct cx_malloc_arena *arena, *retired;
+  size_t nslabs, nslots, nlive, max_live;
 };
 
 struct cx_malloc *cx_malloc_init(struct cx_malloc *alloc,
@@ -19,5 +23,9 @@ struct cx_malloc *cx_malloc_deinit(struct cx_malloc *alloc);
 
 void *cx_malloc(struct cx_malloc *alloc);
 void cx_free(struct cx_malloc *alloc, void *ptr);
+size_t cx_malloc_bytes(struct cx_malloc *alloc);
+
+void cx_malloc_push_arena(struct cx_malloc *alloc);
+bool cx_malloc_pop_arena(struct cx_malloc *alloc);
 
 #endif
@@ -1,3 +1,6 @@
+#include <stdlib.h>
+#include <string.h>
+
 #include "cixl/arg.h"
 #include "cixl/bin.h"
 #include "cixl/call.h"
@@ -6,17 +9,31 @@
 #include "cixl/error.h"
 #include "cixl/fimp.h"
 #include "cixl/func.h"
+#include "cixl/infer.h"
 #include "cixl/lambda.h"
 #include "cixl/op.h"
 #include "cixl/rec.h"
 #include "cixl/scope.h"
 #include "cixl/stack.h"
+#include "cixl/stats.h"
 #include "cixl/str.h"
 #include "cixl/tok.h"
 #include "cixl/type_set.h"
 
+#ifdef CX_STATS
+struct cx_op_type *cx_op_types = NULL;
+#endif
+
 struct cx_op_type *cx_op_type_init(struct cx_op_type *type, const char *id) {
   type->id = id;
+  type->can_fail = true;
+
+#ifdef CX_STATS
+  type->nevals = 0;
+  type->next = cx_op_types;
+  cx_op_types = type;
+#endif
+  
   type->init = NULL;
   type->deinit = NULL;
   type->eval = NULL;
@@ -39,6 +56,7 @@ struct cx_op *cx_op_init(struct cx_op *op,
   op->type = type;
   op->tok_idx = tok_idx;
   op->pc = pc;
+  op->file = NULL;
   op->row = -1; op->col = -1;
   return op;
 }
@@ -195,6 +213,7 @@ static void begin_emit_fimps(struct cx_op *op, struct cx_set *out, struct cx *cx
 }
 
 cx_op_type(CX_OBEGIN, {
+    type.can_fail = false;
     type.eval = begin_eval;
     type.error_eval = begin_error_eval;
     type.emit = begin_emit;
@@ -328,6 +347,7 @@ static bool end_emit(struct cx_op *op, struct cx_bin *bin, FILE *out, struct cx
 }
 
 cx_op_type(CX_OEND, {
+    type.can_fail = false;
     type.eval = type.error_eval = end_eval;
     type.emit = type.error_emit = end_emit;
   });
@@ -390,6 +410,7 @@ static void fimp_emit_fimps(struct cx_op *op, struct cx_set *out, struct cx *cx)
 }
 
 cx_op_type(CX_OFIMP, {
+    type.can_fail = false;
     type.eval = type.error_eval = fimp_eval;
     type.emit = type.error_emit = fimp_emit;
     type.emit_init = fimp_emit_init;
@@ -485,40 +506,392 @@ static void funcdef_emit_syms(struct cx_op *op, struct cx_set *out, struct cx *c
   
   cx_do_vec(&imp->args, struct cx_arg, a) {
     if (a->arg_type == CX_VARG && a->value.type == cx->sym_type) {
-      push(a->value.as_sym);
+      push(*a->value.as_sym);
     }
   }
 
   cx_do_vec(&imp->rets, struct cx_arg, a) {
     if (a->arg_type == CX_VARG && a->value.type == cx->sym_type) {
-      push(a->value.as_sym);
+      push(*a->value.as_sym);
     }
   }
 }
 
 cx_op_type(CX_OFUNCDEF, {
+    type.can_fail = false;
     type.eval = type.error_eval = funcdef_eval;
     type.emit = type.error_emit = funcdef_emit;
     type.emit_init = funcdef_emit_init;
     type.emit_syms = funcdef_emit_syms;
   });
 
+struct cx_funcall_cache *cx_funcall_cache_new(struct cx_func *func) {
+  struct cx_funcall_cache *c =
+    malloc(sizeof(struct cx_funcall_cache) +
+	   CX_FUNCALL_CACHE_SIZE*func->nargs*sizeof(struct cx_type *));
+  
+  c->epoch = 0;
+  c->values = false;
+  c->nargs = func->nargs;
+  c->count = c->next = 0;
+  return c;
+}
+
+static void funcall_cache_reset(struct cx_funcall_cache *c,
+				struct cx_func *func,
+				size_t epoch) {
+  c->epoch = epoch;
+  c->values = false;
+  c->count = c->next = 0;
+
+  cx_do_set(&func->imps, struct cx_fimp *, i) {
+    cx_do_vec(&(*i)->args, struct cx_arg, a) {
+      if (a->arg_type == CX_VARG) { c->values = true; }
+    }
+  }
+}
+
+struct cx_fimp *cx_funcall_match(struct cx_funcall_op *op, struct cx_scope *s) {
+  struct cx *cx = s->cx;
+  struct cx_funcall_cache *c = op->cache;
+  
+  if (c->epoch != cx->dispatch_epoch) {
+    funcall_cache_reset(c, op->func, cx->dispatch_epoch);
+  }
+
+  if (c->values || s->stack.count < c->nargs) {
+    return cx_func_match(op->func, s);
+  }
+  
+  struct cx_box *args = (struct cx_box *)cx_vec_end(&s->stack) - c->nargs;
+  struct cx_type **ts = c->types;
+  
+  for (unsigned int i = 0; i < c->count; i++, ts += c->nargs) {
+    unsigned int j = 0;
+    while (j < c->nargs && ts[j] == args[j].type) { j++; }
+    
+    if (j == c->nargs) {
+      cx->funcall_hits++;
+      return c->imps[i];
+    }
+  }
+
+  cx->funcall_misses++;
+  struct cx_fimp *imp = cx_func_match(op->func, s);
+  if (!imp) { return NULL; }
+  
+  ts = c->types + c->next*c->nargs;
+  for (unsigned int j = 0; j < c->nargs; j++) { ts[j] = args[j].type; }
+  c->imps[c->next] = imp;
+  c->next = (c->next+1) % CX_FUNCALL_CACHE_SIZE;
+  if (c->count < CX_FUNCALL_CACHE_SIZE) { c->count++; }
+  return imp;
+}
+
+static void funcall_deinit(struct cx_op *op) {
+  if (op->as_funcall.cache) { free(op->as_funcall.cache); }
+}
+
+bool cx_jump_call(struct cx *cx,
+		  struct cx_fimp *imp,
+		  struct cx_scope *s,
+		  size_t start_pc,
+		  size_t return_pc) {
+  struct cx_call *call = cx_push_call(cx, cx->row, cx->col, imp, s);
+  if (!call) { return false; }
+  
+  if (!cx_call_pop_args(call)) {
+    cx_pop_call(cx);
+    return false;
+  }
+
+  call->return_pc = return_pc;
+  cx->pc = start_pc;
+  return true;
+}
+
+static bool tail_rets(struct cx_fimp *caller, struct cx_fimp *imp, bool safe) {
+  if (caller->rets.count != imp->rets.count) { return false; }
+  struct cx_arg *cr = cx_vec_start(&caller->rets), *r = cx_vec_start(&imp->rets);
+  
+  for (size_t i = 0; i < imp->rets.count; i++, cr++, r++) {
+    if (cr->arg_type != CX_ARG || cr->id) { return false; }
+    if (!safe) { continue; }
+    struct cx_type *t = (r->arg_type == CX_VARG) ? r->value.type : r->type;
+
+    if (cx_type_has_refs(cr->type) ||
+	cx_type_has_refs(t) ||
+	!cx_is(t, cr->type)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool cx_tail_call(struct cx *cx,
+		  struct cx_fimp *imp,
+		  struct cx_scope *s,
+		  struct cx_fimp *caller,
+		  size_t start_pc,
+		  size_t return_pc) {
+  struct cx_call *call = cx_peek_call(cx);
+  int nargs = imp->func->nargs;
+  
+  if (!call ||
+      call->fimp != caller ||
+      call->recalls ||
+      call->scope != s ||
+      s->stack.count != nargs ||
+      !tail_rets(call->fimp, imp, s->safe)) {
+    return false;
+  }
+
+  struct cx_box args[CX_MAX_ARGS];
+  memcpy(args, s->stack.items, nargs*sizeof(struct cx_box));
+  s->stack.count = 0;
+  cx_call_deinit_args(call);
+  memcpy(call->args, args, nargs*sizeof(struct cx_box));
+  cx_stat(cx_call_stat(call); cx_timer_reset(&call->timer));
+  call->fimp = imp;
+  call->row = cx->row;
+  call->col = cx->col;
+  if (call->return_pc == -1) { call->return_pc = return_pc; }
+  
+  cx_end(cx);
+  cx_pop_lib(cx);
+  cx->pc = start_pc;
+  return true;
+}
+
+struct cx_bin_fimp *cx_jump_target(struct cx *cx,
+				   struct cx_fimp *imp,
+				   ssize_t stop_pc) {
+  if (imp->ptr) { return NULL; }
+  struct cx_bin *bin = cx->bin;
+  
+  // Fimps with their own bin, emitted or native code for instance, only leave
+  // an empty stub behind in calling bins.
+
+  struct cx_bin_fimp *bimp = (!imp->bin || imp->bin == bin)
+    ? cx_set_get(&bin->fimps, &imp)
+    : NULL;
+
+  return (bimp &&
+	  (stop_pc < (ssize_t)bimp->start_pc ||
+	   stop_pc >= (ssize_t)(bimp->start_pc+bimp->nops)))
+    ? bimp
+    : NULL;
+}
+
+static struct cx_op *tail_return(struct cx_op *op, struct cx_bin *bin) {
+  if (op->pc+1 == bin->ops.count) { return NULL; }
+  struct cx_op *ret = op+1;
+
+  while (ret->type == CX_OJUMP()) {
+    if (ret->as_jump.pc >= bin->ops.count) { return NULL; }
+    ret = cx_vec_get(&bin->ops, ret->as_jump.pc);
+  }
+  
+  return (ret->type == CX_ORETURN()) ? ret : NULL;
+}
+
 static bool funcall_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
   struct cx_func *func = op->as_funcall.func;
   struct cx_fimp *imp = op->as_funcall.imp;
   struct cx_scope *s = cx_scope(cx, 0);
   
-  if (imp && s->safe && !cx_fimp_match(imp, s)) { imp = NULL; }
-  if (!imp) { imp = op->as_funcall.imp = cx_func_match(func, s); }
+  if (op->as_funcall.cache && (s->safe || !imp)) {
+    imp = op->as_funcall.imp = cx_funcall_match(&op->as_funcall, s);
+  } else {
+    if (imp && s->safe && !cx_fimp_match(imp, s)) { imp = NULL; }
+    if (!imp) { imp = op->as_funcall.imp = cx_func_match(func, s); }
+  }
   
   if (!imp) {
     cx_error(cx, cx->row, cx->col, "Func not applicable: %s", func->id);
     return false;
   }
+
+  if (!imp->ptr && !imp->native &&
+      cx->tier_calls && ++imp->ncalls == cx->tier_calls) {
+    cx_fimp_native(imp, cx->tier_dir);
+    return cx_fimp_call(imp, s);
+  }
+
+  struct cx_bin_fimp *bimp = cx_jump_target(cx, imp, cx->stop_pc);
+
+  if (bimp) {
+    struct cx_op *ret = tail_return(op, bin);
+
+    return (ret &&
+	    cx_tail_call(cx, imp, s, ret->as_return.imp,
+			 bimp->start_pc, ret->pc+1)) ||
+      cx_jump_call(cx, imp, s, bimp->start_pc, cx->pc);
+  }
   
   return cx_fimp_call(imp, s);
 }
 
+static bool funcall_emit_unboxed(struct cx_op *op,
+				 struct cx_infer *i,
+				 FILE *out,
+				 struct cx *cx) {
+  struct cx_fimp *imp = i->imp;
+  struct cx_func *func = imp->func;
+  struct cx_type *t = i->args[0];
+  if (!imp->ptr || imp->lib != func->lib) { return false; }
+  if (t != cx->int_type && t != cx->float_type) { return false; }
+  
+  for (int j = 1; j < func->nargs; j++) {
+    if (i->args[j] != t) { return false; }
+  }
+
+  struct {
+    const char *lib, *func, *expr;
+    bool cmp;
+  } *k, kinds[] = {
+    {"cx/math", "++", "x+1", false},
+    {"cx/math", "--", "x-1", false},
+    {"cx/math", "+", "x+y", false},
+    {"cx/math", "-", "x-y", false},
+    {"cx/math", "*", "x*y", false},
+    {"cx/cond", "=", "x == y", true},
+    {"cx/cond", "<", "x < y", true},
+    {"cx/cond", ">", "x > y", true},
+    {"cx/cond", "<=", "x <= y", true},
+    {"cx/cond", ">=", "x >= y", true},
+    {NULL, NULL, NULL, false}
+  };
+
+  for (k = kinds; k->lib; k++) {
+    if (strcmp(func->lib->id.id, k->lib) == 0 && strcmp(func->id, k->func) == 0) {
+      break;
+    }
+  }
+
+  if (!k->lib || (k->cmp && t != cx->int_type)) { return false; }
+  bool is_int = t == cx->int_type;
+  
+  const char
+    *ct = is_int ? "int64_t" : "cx_float_t",
+    *f = is_int ? "as_int" : "as_float";
+
+  if (func->nargs == 1) {
+    fprintf(out, "%s x = xs[0].%s;\n", ct, f);
+  } else {
+    fprintf(out,
+	    "%s x = xs[0].%s, y = xs[1].%s;\n"
+	    "s->stack.count--;\n",
+	    ct, f, f);
+  }
+
+  if (k->cmp) {
+    fprintf(out, "cx_box_init(xs, cx->bool_type)->as_bool = %s;\n", k->expr);
+  } else {
+    fprintf(out,
+	    "cx_box_init(xs, %s)->%s = %s;\n",
+	    is_int ? "cx->int_type" : "cx->float_type", f, k->expr);
+  }
+  
+  return true;
+}
+
+static const char *emit_type_ref(struct cx_type *t, struct cx *cx) {
+  struct {
+    struct cx_type *type;
+    const char *ref;
+  } refs[] = {
+    {cx->bool_type,  "cx->bool_type"},
+    {cx->char_type,  "cx->char_type"},
+    {cx->float_type, "cx->float_type"},
+    {cx->int_type,   "cx->int_type"},
+    {cx->nil_type,   "cx->nil_type"},
+    {cx->str_type,   "cx->str_type"},
+    {cx->sym_type,   "cx->sym_type"},
+    {cx->time_type,  "cx->time_type"}
+  };
+
+  for (int i = 0; i < sizeof(refs) / sizeof(refs[0]); i++) {
+    if (refs[i].type && refs[i].type == t) { return refs[i].ref; }
+  }
+
+  return NULL;
+}
+
+static void funcall_emit_call(struct cx_op *op,
+			      struct cx_bin *bin,
+			      const char *imp,
+			      FILE *out,
+			      struct cx *cx) {
+  fprintf(out,
+	  "struct cx_bin_fimp *bimp = cx_jump_target(cx, %s, stop_pc);\n\n"
+	  "if (bimp) {\n",
+	  imp);
+
+  struct cx_op *ret = tail_return(op, bin);
+
+  if (ret) {
+    fprintf(out,
+	    "  if (cx_tail_call(cx, %s, s, %s(), bimp->start_pc, %zd)) {\n"
+	    "    goto *op_labels[cx->pc];\n"
+	    "  }\n\n",
+	    imp, ret->as_return.imp->emit_id, ret->pc+1);
+  }
+
+  fprintf(out,
+	  "  if (!cx_jump_call(cx, %s, s, bimp->start_pc, %zd)) { goto op%zd; }\n"
+	  "  goto *op_labels[cx->pc];\n"
+	  "}\n\n"
+	  "if (!cx_fimp_call(%s, s)) { goto op%zd; }\n",
+	  imp, op->pc+1, op->pc+1, imp, op->pc+1);
+}
+
+static void funcall_emit_spec(struct cx_op *op,
+			      struct cx_bin *bin,
+			      struct cx_infer *i,
+			      FILE *out,
+			      struct cx *cx) {
+  int nargs = i->imp->func->nargs;
+  
+  for (int j = 0; j < nargs; j++) {
+    if (!emit_type_ref(i->args[j], cx)) { return; }
+  }
+
+  if (nargs) {
+    fprintf(out,
+	    "if (s->stack.count >= %d) {\n"
+	    "struct cx_box *xs = (struct cx_box *)cx_vec_end(&s->stack)-%d;\n"
+	    "if (",
+	    nargs, nargs);
+    
+    for (int j = 0; j < nargs; j++) {
+      fprintf(out,
+	      "%sxs[%d].type == %s",
+	      j ? " && " : "", j, emit_type_ref(i->args[j], cx));
+    }
+
+    fputs(") {\n", out);
+  } else {
+    fputs("{\n{\n", out);
+  }
+
+  if (!i->imp->ptr) {
+    fprintf(out, "struct cx_fimp *imp = %s();\n", i->imp->emit_id);
+    funcall_emit_call(op, bin, "imp", out, cx);
+  } else if (!nargs || !funcall_emit_unboxed(op, i, out, cx)) {
+    fprintf(out,
+	    "if (!cx_fimp_call(%s(), s)) { goto op%zd; }\n",
+	    i->imp->emit_id, op->pc+1);
+  }
+  
+  fprintf(out,
+	  "goto op%zd;\n"
+	  "}\n"
+	  "}\n\n",
+	  op->pc+1);
+}
+
 static bool funcall_emit(struct cx_op *op,
 			 struct cx_bin *bin,
 			 FILE *out,
@@ -526,20 +899,36 @@ static bool funcall_emit(struct cx_op *op,
   struct cx_func *func = op->as_funcall.func;
   struct cx_fimp *imp = op->as_funcall.imp;
   struct cx_sym imp_var = cx_gsym(cx, "imp");
-  
-  fprintf(out,
-	  "struct cx_scope *s = cx_scope(cx, 0);\n"
-	  "static struct cx_fimp *%s = NULL;\n",
-	  imp_var.id);
+  fputs("struct cx_scope *s = cx_scope(cx, 0);\n", out);
+  struct cx_infer *i = bin->infer ? bin->infer+op->pc : NULL;
+  if (i && i->imp) { funcall_emit_spec(op, bin, i, out, cx); }
+  fprintf(out, "static struct cx_fimp *%s = NULL;\n", imp_var.id);
 
   if (imp) {
     fprintf(out, "if (!%s) { %s = %s(); }\n", imp_var.id, imp_var.id, imp->emit_id);
   }
 
-  fprintf(out,
-	  "if (%s && s->safe && !cx_fimp_match(%s, s)) { %s = NULL; }\n"
-	  "if (!%s) { %s = cx_func_match(%s(), s); }\n\n",
-	  imp_var.id, imp_var.id, imp_var.id, imp_var.id, imp_var.id, func->emit_id);
+  if (op->as_funcall.cache) {
+    struct cx_sym call_var = cx_gsym(cx, "call");
+
+    fprintf(out,
+	    "static struct cx_funcall_op %s = {NULL, NULL, NULL};\n"
+	    "if (!%s.cache) {\n"
+	    "  %s.func = %s();\n"
+	    "  %s.cache = cx_funcall_cache_new(%s.func);\n"
+	    "}\n\n"
+	    "if (s->safe || !%s) { %s = cx_funcall_match(&%s, s); }\n\n",
+	    call_var.id,
+	    call_var.id,
+	    call_var.id, func->emit_id,
+	    call_var.id, call_var.id,
+	    imp_var.id, imp_var.id, call_var.id);
+  } else {
+    fprintf(out,
+	    "if (%s && s->safe && !cx_fimp_match(%s, s)) { %s = NULL; }\n"
+	    "if (!%s) { %s = cx_func_match(%s(), s); }\n\n",
+	    imp_var.id, imp_var.id, imp_var.id, imp_var.id, imp_var.id, func->emit_id);
+  }
   
   fprintf(out,
 	  "if (!%s) {\n"
@@ -548,7 +937,7 @@ static bool funcall_emit(struct cx_op *op,
 	  "}\n\n",
 	  imp_var.id, func->id, op->pc+1);
   
-  fprintf(out, "if (!cx_fimp_call(%s, s)) { goto op%zd; }\n", imp_var.id, op->pc+1);
+  funcall_emit_call(op, bin, imp_var.id, out, cx);
   return true;
 }
 
@@ -570,16 +959,39 @@ static void funcall_emit_fimps(struct cx_op *op, struct cx_set *out, struct cx *
 }
 
 cx_op_type(CX_OFUNCALL, {
+    type.deinit = funcall_deinit;
     type.eval = funcall_eval;
     type.emit = funcall_emit;
     type.emit_funcs = funcall_emit_funcs;
     type.emit_fimps = funcall_emit_fimps;
   });
 
+static void getconst_deinit(struct cx_op *op) {
+  if (op->as_getconst.lib) { cx_box_deinit(&op->as_getconst.value); }
+}
+
 static bool getconst_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
-  struct cx_box *v = cx_get_const(cx, op->as_getconst.id, false);
-  if (!v) { return false; }
-  cx_copy(cx_push(cx_scope(cx, 0)), v);
+  struct cx_getconst_op *c = &op->as_getconst;
+
+  // Values are copied into the op on first use and only looked up again
+  // when the current lib changes or consts are added or redefined.
+  
+  if (c->lib != *cx->lib || c->epoch != cx->const_epoch) {
+    getconst_deinit(op);
+    struct cx_box *v = cx_lib_get_const(*cx->lib, c->id, true);
+    c->lib = v ? *cx->lib : NULL;
+    c->epoch = cx->const_epoch;
+    
+    if (!v) {
+      if (!(v = cx_get_const(cx, c->id, false))) { return false; }
+      cx_copy(cx_push(cx_scope(cx, 0)), v);
+      return true;
+    }
+
+    cx_copy(&c->value, v);
+  }
+  
+  cx_copy(cx_push(cx_scope(cx, 0)), &c->value);
   return true;
 }
 
@@ -587,11 +999,23 @@ static bool getconst_emit(struct cx_op *op,
 			  struct cx_bin *bin,
 			  FILE *out,
 			  struct cx *cx) {
+  const char *id = op->as_getconst.id.emit_id;
+  
   fprintf(out,
-	  "struct cx_box *v = cx_get_const(cx, %s, false);\n"
+	  "static struct cx_lib *lib = NULL;\n"
+	  "static size_t epoch = 0;\n"
+	  "static struct cx_box *v = NULL;\n\n"
+	  
+	  "if (lib != *cx->lib || epoch != cx->const_epoch) {\n"
+	  "  v = cx_lib_get_const(*cx->lib, %s, true);\n"
+	  "  lib = v ? *cx->lib : NULL;\n"
+	  "  epoch = cx->const_epoch;\n"
+	  "  if (!v) { v = cx_get_const(cx, %s, false); }\n"
+	  "}\n\n"
+	  
 	  "if (!v) { goto op%zd; }\n"
 	  "cx_copy(cx_push(cx_scope(cx, 0)), v);\n",
-	  op->as_getconst.id.emit_id, op->pc+1);
+	  id, id, op->pc+1);
   
   return true;
 }
@@ -605,6 +1029,7 @@ static void getconst_emit_syms(struct cx_op *op, struct cx_set *out, struct cx *
 }
 
 cx_op_type(CX_OGETCONST, {
+    type.deinit = getconst_deinit;
     type.eval = getconst_eval;
     type.emit = getconst_emit;
     type.emit_syms = getconst_emit_syms;
@@ -612,8 +1037,12 @@ cx_op_type(CX_OGETCONST, {
 
 static bool getvar_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
   struct cx_scope *s = cx_scope(cx, 0);
-  struct cx_sym id = op->as_getvar.id;
-  struct cx_box *v = cx_get_var(s, id, false);
+  struct cx_getvar_op *g = &op->as_getvar;
+  
+  struct cx_box *v = (g->slot == -1)
+    ? cx_get_var(s, g->id, false)
+    : cx_get_slot(s, g->depth, g->slot, g->id, false);
+  
   if (!v) { return false; }
   cx_copy(cx_push(s), v);
   return true;
@@ -623,12 +1052,21 @@ static bool getvar_emit(struct cx_op *op,
 			struct cx_bin *bin,
 			FILE *out,
 			struct cx *cx) {
+  struct cx_getvar_op *g = &op->as_getvar;
+  fputs("struct cx_scope *s = cx_scope(cx, 0);\n", out);
+
+  if (g->slot == -1) {
+    fprintf(out, "struct cx_box *v = cx_get_var(s, %s, false);\n", g->id.emit_id);
+  } else {
+    fprintf(out,
+	    "struct cx_box *v = cx_get_slot(s, %u, %zd, %s, false);\n",
+	    g->depth, g->slot, g->id.emit_id);
+  }
+  
   fprintf(out,
-	  "struct cx_scope *s = cx_scope(cx, 0);\n"
-	  "struct cx_box *v = cx_get_var(s, %s, false);\n"
 	  "if (!v) { goto op%zd; }\n"
 	  "cx_copy(cx_push(s), v);\n",
-	  op->as_getvar.id.emit_id, op->pc+1);
+	  op->pc+1);
 
   return true;
 }
@@ -648,6 +1086,20 @@ cx_op_type(CX_OGETVAR, {
     type.emit_syms = getvar_emit_syms;
   });
 
+static bool getcall_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
+  struct cx_op *call = op+1;
+  cx->pc++;
+  if (!getvar_eval(op, bin, cx)) { return false; }
+  cx->row = call->row; cx->col = call->col;
+  return funcall_eval(call, bin, cx);
+}
+
+cx_op_type(CX_OGETCALL, {
+    type.eval = getcall_eval;
+    type.emit = getvar_emit;
+    type.emit_syms = getvar_emit_syms;
+  });
+
 static bool jump_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
   cx->pc = op->as_jump.pc;
   return true;
@@ -662,6 +1114,7 @@ static bool jump_emit(struct cx_op *op,
 }
 
 cx_op_type(CX_OJUMP, {
+    type.can_fail = false;
     type.eval = type.error_eval = jump_eval;
     type.emit = type.error_emit = jump_emit;
   });
@@ -703,6 +1156,7 @@ static bool lambda_error_emit(struct cx_op *op,
 }
 
 cx_op_type(CX_OLAMBDA, {
+    type.can_fail = false;
     type.eval = lambda_eval;
     type.error_eval = lambda_error_eval;
     type.emit = lambda_emit;
@@ -768,6 +1222,7 @@ static void poplib_emit_init(struct cx_op *op,
 }
 
 cx_op_type(CX_OPOPLIB, {
+    type.can_fail = false;
     type.eval = type.error_eval = poplib_eval;
     type.emit = type.error_emit = poplib_emit;
     type.emit_init = poplib_emit_init;
@@ -814,8 +1269,8 @@ static void push_emit_syms(struct cx_op *op, struct cx_set *out, struct cx *cx)
   struct cx_box *v = &op->as_push.value;
 
   if (v->type == cx->sym_type) {
-    struct cx_sym *ok = cx_set_insert(out, &v->as_sym);
-    if (ok) { *ok = v->as_sym; }
+    struct cx_sym *ok = cx_set_insert(out, v->as_sym);
+    if (ok) { *ok = *v->as_sym; }
   }
 }
 
@@ -829,6 +1284,7 @@ static void push_emit_types(struct cx_op *op, struct cx_set *out, struct cx *cx)
 }
 
 cx_op_type(CX_OPUSH, {
+    type.can_fail = false;
     type.deinit = push_deinit;
     type.eval = push_eval;
     type.emit = push_emit;
@@ -838,6 +1294,106 @@ cx_op_type(CX_OPUSH, {
     type.emit_types = push_emit_types;
   });
 
+static bool pushcall_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
+  struct cx_op *call = op+1;
+  struct cx_scope *s = cx_scope(cx, 0);
+  int64_t y = op->as_pushcall.value;
+  cx->pc++;
+  cx->row = call->row; cx->col = call->col;
+  
+  if (s->stack.count && call->as_funcall.imp == op->as_pushcall.imp) {
+    struct cx_box *x = cx_vec_peek(&s->stack, 0);
+
+    if (x->type == cx->int_type) {
+      switch (op->as_pushcall.kind) {
+      case CX_PUSHCALL_ADD:
+	x->as_int += y;
+	return true;
+      case CX_PUSHCALL_SUB:
+	x->as_int -= y;
+	return true;
+      case CX_PUSHCALL_MUL:
+	x->as_int *= y;
+	return true;
+      case CX_PUSHCALL_DIV:
+	if (!y) { break; }
+	x->as_int /= y;
+	return true;
+      case CX_PUSHCALL_MOD:
+	if (!y) { break; }
+	x->as_int %= y;
+	return true;
+      case CX_PUSHCALL_EQ: {
+	bool ok = x->as_int == y;
+	cx_box_init(x, cx->bool_type)->as_bool = ok;
+	return true;
+      }
+      case CX_PUSHCALL_LT: {
+	bool ok = x->as_int < y;
+	cx_box_init(x, cx->bool_type)->as_bool = ok;
+	return true;
+      }
+      case CX_PUSHCALL_GT: {
+	bool ok = x->as_int > y;
+	cx_box_init(x, cx->bool_type)->as_bool = ok;
+	return true;
+      }
+      case CX_PUSHCALL_LTE: {
+	bool ok = x->as_int <= y;
+	cx_box_init(x, cx->bool_type)->as_bool = ok;
+	return true;
+      }
+      case CX_PUSHCALL_GTE: {
+	bool ok = x->as_int >= y;
+	cx_box_init(x, cx->bool_type)->as_bool = ok;
+	return true;
+      }
+      }
+    }
+  }
+
+  cx_box_init(cx_push(s), cx->int_type)->as_int = y;
+  return funcall_eval(call, bin, cx);
+}
+
+static bool pushcall_emit(struct cx_op *op,
+			  struct cx_bin *bin,
+			  FILE *out,
+			  struct cx *cx) {
+  struct cx_box v;
+  cx_box_init(&v, cx->int_type)->as_int = op->as_pushcall.value;
+  return cx_box_emit(&v, "cx_push(cx_scope(cx, 0))", out);
+}
+
+cx_op_type(CX_OPUSHCALL, {
+    type.can_fail = false;
+    type.eval = pushcall_eval;
+    type.emit = pushcall_emit;
+  });
+
+static struct cx_box *put_var(struct cx_scope *s, struct cx_putvar_op *p) {
+  return (p->slot == -1) ? cx_put_var(s, p->id) : cx_put_slot(s, p->slot, p->id);
+}
+
+static bool pushput_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
+  struct cx_op *put = op+1;
+  cx->pc++;
+  cx->row = put->row; cx->col = put->col;
+  cx_copy(put_var(cx_scope(cx, 0), &put->as_putvar), &op->as_push.value);
+  return true;
+}
+
+cx_op_type(CX_OPUSHPUT, {
+    type.can_fail = false;
+    type.deinit = push_deinit;
+    type.eval = pushput_eval;
+    type.emit = push_emit;
+    type.emit_funcs = push_emit_funcs;
+    type.emit_fimps = push_emit_fimps;
+    type.emit_syms = push_emit_syms;
+    type.emit_types = push_emit_types;
+  });
+
 static bool pushlib_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
   cx_push_lib(cx, op->as_pushlib.lib);
   return true;
@@ -874,6 +1430,7 @@ static void pushlib_emit_libs(struct cx_op *op,
 }
 
 cx_op_type(CX_OPUSHLIB, {
+    type.can_fail = false;
     type.eval = type.error_eval = pushlib_eval;
     type.emit = type.error_emit = pushlib_emit;
     type.emit_init = pushlib_emit_init;
@@ -890,9 +1447,16 @@ static bool putargs_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
   struct cx_box *v = call->args;
   struct cx_scope *s = cx_scope(cx, 0);
   
-  for(; nargs--; a++, v++) {
-    if (a->arg_type != CX_VARG) {
-      cx_copy(a->id ? cx_put_var(s, a->sym_id) : cx_push(s), v);
+  for(int i = 0; i < nargs; i++, a++, v++) {
+    if (a->arg_type == CX_VARG) { continue; }
+    
+    if (!a->id) {
+      cx_copy(cx_push(s), v);
+    } else {
+      cx_copy(op->as_putargs.slots
+	      ? cx_put_slot(s, i, a->sym_id)
+	      : cx_put_var(s, a->sym_id),
+	      v);
     }
   }
   
@@ -914,7 +1478,11 @@ static bool putargs_emit(struct cx_op *op,
   
   for(int i=0; i < imp->func->nargs; i++, a++) {
     if (a->arg_type != CX_VARG) {
-      if (a->id) {
+      if (a->id && op->as_putargs.slots) {
+	fprintf(out,
+		"cx_copy(cx_put_slot(s, %d, %s), a);\n",
+		i, a->sym_id.emit_id);
+      } else if (a->id) {
 	fprintf(out,
 		"cx_copy(cx_put_var(s, %s), a);\n",
 		a->sym_id.emit_id);
@@ -959,6 +1527,7 @@ static void putargs_emit_syms(struct cx_op *op, struct cx_set *out, struct cx *c
 }
 
 cx_op_type(CX_OPUTARGS, {
+    type.can_fail = false;
     type.eval = putargs_eval;
     type.emit = putargs_emit;
     type.emit_funcs = putargs_emit_funcs;
@@ -1022,7 +1591,7 @@ static bool putvar_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
     return false;
   }
   
-  *cx_put_var(s, op->as_putvar.id) = *src;
+  *put_var(s, &op->as_putvar) = *src;
   return true;
 }
 
@@ -1047,9 +1616,15 @@ static bool putvar_emit(struct cx_op *op,
 	    op->as_putvar.type->emit_id, op->as_putvar.type->id, op->pc+1);
   }
   
-  fprintf(out,
-	  "*cx_put_var(s, %s) = *src;\n",
-	  op->as_putvar.id.emit_id);
+  if (op->as_putvar.slot == -1) {
+    fprintf(out,
+	    "*cx_put_var(s, %s) = *src;\n",
+	    op->as_putvar.id.emit_id);
+  } else {
+    fprintf(out,
+	    "*cx_put_slot(s, %zd, %s) = *src;\n",
+	    op->as_putvar.slot, op->as_putvar.id.emit_id);
+  }
 
   return true;
 }
@@ -1161,19 +1736,24 @@ static bool return_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
       return false;
     }
 
+    ssize_t return_pc = call->return_pc;
     cx_vec_clear(&ss->stack);
     cx_end(cx);
     cx_pop_lib(cx);
     if (!cx_pop_call(cx)) { return false; }
+    if (return_pc > -1) { cx->pc = return_pc; }
   }
   
   return true;
 }
 
 static bool return_error_eval(struct cx_op *op, struct cx_bin *bin, struct cx *cx) {
+  struct cx_call *call = cx_test(cx_peek_call(cx));
+  ssize_t return_pc = call->return_pc;
   cx_end(cx);
   cx_pop_lib(cx);
   if (!cx_pop_call(cx)) { return false; }
+  if (return_pc > -1) { cx->pc = return_pc; }
   return true;
 }
 
@@ -1283,10 +1863,12 @@ static bool return_emit(struct cx_op *op,
 	  "    goto op%zd;\n"
 	  "  }\n\n"
 	  
+	  "  ssize_t return_pc = call->return_pc;\n"
 	  "  cx_vec_clear(&s->stack);\n"
 	  "  cx_end(cx);\n"
 	  "  cx_pop_lib(cx);\n"
 	  "  if (!cx_pop_call(cx)) { goto op%zd; }\n"
+	  "  if (return_pc > -1) { goto *op_labels[return_pc]; }\n"
 	  "}\n",
 	  op->pc+1, op->pc+1);
   
@@ -1298,9 +1880,12 @@ static bool return_error_emit(struct cx_op *op,
 			      FILE *out,
 			      struct cx *cx) {
   fprintf(out,
+	  "struct cx_call *call = cx_test(cx_peek_call(cx));\n"
+	  "ssize_t return_pc = call->return_pc;\n"
 	  "cx_end(cx);\n"
 	  "cx_pop_lib(cx);\n"
-	  "if (!cx_pop_call(cx)) { goto op%zd; }\n",
+	  "if (!cx_pop_call(cx)) { goto op%zd; }\n"
+	  "if (return_pc > -1) { goto *op_labels[return_pc]; }\n",
 	  op->pc+1);
 
   return true;
@@ -1359,6 +1944,7 @@ static bool stash_emit(struct cx_op *op,
 }
 
 cx_op_type(CX_OSTASH, {
+    type.can_fail = false;
     type.eval = stash_eval;
     type.emit = stash_emit;
   });
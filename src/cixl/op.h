@@ -19,6 +19,7 @@
     return &type;				\
   }						\
 
+struct cx_bin_fimp;
 struct cx_call;
 struct cx_func;
 struct cx_fimp;
@@ -27,6 +28,12 @@ struct cx_tok;
   
 struct cx_op_type {
   const char *id;
+  bool can_fail;
+
+#ifdef CX_STATS
+  size_t nevals;
+  struct cx_op_type *next;
+#endif
   
   void (*init)(struct cx_op *, struct cx_tok *);
   void (*deinit)(struct cx_op *);
@@ -46,6 +53,10 @@ struct cx_op_type {
   void (*emit_libs)(struct cx_op *, struct cx_bin *, struct cx_set *, struct cx *);
 };
 
+#ifdef CX_STATS
+extern struct cx_op_type *cx_op_types;
+#endif
+
 struct cx_op_type *cx_op_type_init(struct cx_op_type *type, const char *id);
 
 struct cx_argref_op {
@@ -76,17 +87,54 @@ struct cx_funcdef_op {
   struct cx_fimp *imp;
 };
 
+#define CX_FUNCALL_CACHE_SIZE 4
+
+struct cx_funcall_cache {
+  size_t epoch;
+  bool values;
+  unsigned int nargs, count, next;
+  struct cx_fimp *imps[CX_FUNCALL_CACHE_SIZE];
+  struct cx_type *types[];
+};
+
+struct cx_funcall_cache *cx_funcall_cache_new(struct cx_func *func);
+
 struct cx_funcall_op {
   struct cx_func *func;
   struct cx_fimp *imp;
+  struct cx_funcall_cache *cache;
 };
 
+struct cx_fimp *cx_funcall_match(struct cx_funcall_op *op, struct cx_scope *s);
+
+struct cx_bin_fimp *cx_jump_target(struct cx *cx,
+				   struct cx_fimp *imp,
+				   ssize_t stop_pc);
+
+bool cx_jump_call(struct cx *cx,
+		  struct cx_fimp *imp,
+		  struct cx_scope *s,
+		  size_t start_pc,
+		  size_t return_pc);
+
+bool cx_tail_call(struct cx *cx,
+		  struct cx_fimp *imp,
+		  struct cx_scope *s,
+		  struct cx_fimp *caller,
+		  size_t start_pc,
+		  size_t return_pc);
+
 struct cx_getconst_op {
   struct cx_sym id;
+  struct cx_lib *lib;
+  size_t epoch;
+  struct cx_box value;
 };
 
 struct cx_getvar_op {
   struct cx_sym id;
+  unsigned int depth;
+  ssize_t slot;
 };
 
 struct cx_jump_op {
@@ -106,12 +154,25 @@ struct cx_push_op {
   struct cx_box value;
 };
 
+enum cx_pushcall_kind {CX_PUSHCALL_ADD, CX_PUSHCALL_SUB,
+		       CX_PUSHCALL_MUL, CX_PUSHCALL_DIV, CX_PUSHCALL_MOD,
+		       CX_PUSHCALL_EQ,
+		       CX_PUSHCALL_LT, CX_PUSHCALL_GT,
+		       CX_PUSHCALL_LTE, CX_PUSHCALL_GTE};
+
+struct cx_pushcall_op {
+  int64_t value;
+  struct cx_fimp *imp;
+  enum cx_pushcall_kind kind;
+};
+
 struct cx_pushlib_op {
   struct cx_lib *lib;
 };
 
 struct cx_putargs_op {
   struct cx_fimp *imp;
+  bool slots;
 };
 
 struct cx_putconst_op {
@@ -122,6 +183,7 @@ struct cx_putconst_op {
 struct cx_putvar_op {
   struct cx_sym id;
   struct cx_type *type;
+  ssize_t slot;
 };
 
 struct cx_return_op {
@@ -136,6 +198,7 @@ struct cx_typedef_op {
 struct cx_op {
   struct cx_op_type *type;
   ssize_t tok_idx, pc;
+  const char *file;
   int row, col;
   
   union {
@@ -152,6 +215,7 @@ struct cx_op {
     struct cx_lambda_op   as_lambda;
     struct cx_libdef_op   as_libdef;
     struct cx_push_op     as_push;
+    struct cx_pushcall_op as_pushcall;
     struct cx_pushlib_op  as_pushlib;
     struct cx_putargs_op  as_putargs;
     struct cx_putconst_op as_putconst;
@@ -181,6 +245,7 @@ struct cx_op_type *CX_OELSE();
 struct cx_op_type *CX_OFIMP();
 struct cx_op_type *CX_OFUNCDEF();
 struct cx_op_type *CX_OFUNCALL();
+struct cx_op_type *CX_OGETCALL();
 struct cx_op_type *CX_OGETCONST();
 struct cx_op_type *CX_OGETVAR();
 struct cx_op_type *CX_OJUMP();
@@ -188,7 +253,9 @@ struct cx_op_type *CX_OLAMBDA();
 struct cx_op_type *CX_OLIBDEF();
 struct cx_op_type *CX_OPOPLIB();
 struct cx_op_type *CX_OPUSH();
+struct cx_op_type *CX_OPUSHCALL();
 struct cx_op_type *CX_OPUSHLIB();
+struct cx_op_type *CX_OPUSHPUT();
 struct cx_op_type *CX_OPUTARGS();
 struct cx_op_type *CX_OPUTCONST();
 struct cx_op_type *CX_OPUTVAR();
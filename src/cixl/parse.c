@@ -185,7 +185,7 @@ static bool parse_id(struct cx *cx, FILE *in, struct cx_vec *out, bool eval_macr
       
       cx_tok_init(cx_vec_push(out),
 		  CX_TID(),
-		  row, col)->as_ptr = args ? args : strdup(s);
+		  cx->file, row, col)->as_ptr = args ? args : strdup(s);
     } else {
       cx_error(cx, row, col, "Failed parsing id");
     }
@@ -232,7 +232,7 @@ static bool parse_num(struct cx *cx, FILE *in, struct cx_vec *out) {
 	
 	struct cx_box *box = &cx_tok_init(cx_vec_push(out),
 					  CX_TLITERAL(),
-					  row, col)->as_box;
+					  cx->file, row, col)->as_box;
 	
 	cx_box_init(box, cx->float_type)->as_float = v;
       } else {
@@ -247,7 +247,7 @@ static bool parse_num(struct cx *cx, FILE *in, struct cx_vec *out) {
 	
 	struct cx_box *box = &cx_tok_init(cx_vec_push(out),
 					  CX_TLITERAL(),
-					  row, col)->as_box;
+					  cx->file, row, col)->as_box;
 	
 	cx_box_init(box, cx->int_type)->as_int = v;
       }
@@ -321,7 +321,7 @@ static bool parse_char(struct cx *cx, FILE *in, struct cx_vec *out) {
   
   struct cx_box *box = &cx_tok_init(cx_vec_push(out),
 				    CX_TLITERAL(),
-				    cx->row, cx->col)->as_box;
+				    cx->file, cx->row, cx->col)->as_box;
   cx_box_init(box, cx->char_type)->as_char = c;
   return true;
 }
@@ -365,12 +365,12 @@ static bool parse_str(struct cx *cx, FILE *in, struct cx_vec *out) {
     if (ok) {
       struct cx_box *box = &cx_tok_init(cx_vec_push(out),
 					CX_TLITERAL(),
-					row, col)->as_box;
+					cx->file, row, col)->as_box;
 
       fflush(value.stream);
       
       cx_box_init(box, cx->str_type)->as_str =
-	cx_str_new(value.data, ftell(value.stream));
+	cx_str_new(cx, value.data, ftell(value.stream));
     }
 
     cx_mfile_close(&value);
@@ -406,8 +406,8 @@ static bool parse_sym(struct cx *cx, FILE *in, struct cx_vec *out) {
   if (ok) {
     struct cx_box *box = &cx_tok_init(cx_vec_push(out),
 				      CX_TLITERAL(),
-				      cx->row, col)->as_box;
-    cx_box_init(box, cx->sym_type)->as_sym = cx_sym(cx, id.data);
+				      cx->file, cx->row, col)->as_box;
+    cx_box_init(box, cx->sym_type)->as_sym = cx_intern(cx, id.data);
   }
   
   free(id.data);
@@ -421,7 +421,7 @@ static bool parse_group(struct cx *cx, FILE *in,
   cx->col++;
   struct cx_vec *body = &cx_tok_init(cx_vec_push(out),
 				     CX_TGROUP(),
-				     cx->row, cx->col)->as_vec;
+				     cx->file, cx->row, cx->col)->as_vec;
   cx_vec_init(body, sizeof(struct cx_tok));
 
   while (true) {
@@ -446,7 +446,7 @@ static bool parse_stack(struct cx *cx, FILE *in,
   cx->col++;
   struct cx_vec *body = &cx_tok_init(cx_vec_push(out),
 				     CX_TSTACK(),
-				     cx->row, cx->col)->as_vec;
+				     cx->file, cx->row, cx->col)->as_vec;
   cx_vec_init(body, sizeof(struct cx_tok));
 
   while (true) {
@@ -473,7 +473,7 @@ static bool parse_lambda(struct cx *cx, FILE *in,
   
   struct cx_vec *body = &cx_tok_init(cx_vec_push(out),
 				     CX_TLAMBDA(),
-				     row, col)->as_vec;
+				     cx->file, row, col)->as_vec;
   cx_vec_init(body, sizeof(struct cx_tok));
 
   while (true) {
@@ -509,22 +509,22 @@ bool cx_parse_tok(struct cx *cx, FILE *in, struct cx_vec *out, bool eval_macros)
       done = true;
       break;
     case ';':
-      cx_tok_init(cx_vec_push(out), CX_TEND(), row, col);
+      cx_tok_init(cx_vec_push(out), CX_TEND(), cx->file, row, col);
       return true;
     case '(':
       return parse_group(cx, in, out, eval_macros);
     case ')':
-      cx_tok_init(cx_vec_push(out), CX_TUNGROUP(), row, col);
+      cx_tok_init(cx_vec_push(out), CX_TUNGROUP(), cx->file, row, col);
       return true;	
     case '[':
       return parse_stack(cx, in, out, eval_macros);
     case ']':
-      cx_tok_init(cx_vec_push(out), CX_TUNSTACK(), row, col);
+      cx_tok_init(cx_vec_push(out), CX_TUNSTACK(), cx->file, row, col);
       return true;	
     case '{':
       return parse_lambda(cx, in, out, eval_macros);
     case '}':
-      cx_tok_init(cx_vec_push(out), CX_TUNLAMBDA(), row, col);
+      cx_tok_init(cx_vec_push(out), CX_TUNLAMBDA(), cx->file, row, col);
       return true;
     case '@':
       return parse_char(cx, in, out);
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cixl/bin.h"
+#include "cixl/cx.h"
+#include "cixl/error.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/lib.h"
+#include "cixl/op.h"
+#include "cixl/peephole.h"
+#include "cixl/scope.h"
+
+struct cx_peephole *cx_peephole_init(struct cx_peephole *p) {
+  p->enabled = true;
+  p->folds = p->push_calls = p->get_calls = p->push_puts = p->scopes = 0;
+  return p;
+}
+
+static void mark(size_t *targets, struct cx_bin *bin, ssize_t pc) {
+  if (pc >= 0 && pc <= bin->ops.count) { targets[pc]++; }
+}
+
+size_t *cx_find_targets(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  size_t *ts = calloc(bin->ops.count+1, sizeof(size_t));
+
+  for (size_t i = start_pc; i < bin->ops.count; i++) {
+    struct cx_op *op = cx_vec_get(&bin->ops, i);
+
+    if (op->type == CX_OBEGIN()) {
+      mark(ts, bin, i+1+op->as_begin.nops);
+    } else if (op->type == CX_OCATCH()) {
+      mark(ts, bin, i+1);
+      mark(ts, bin, i+1+op->as_catch.nops);
+    } else if (op->type == CX_OELSE()) {
+      mark(ts, bin, i+1+op->as_else.nops);
+    } else if (op->type == CX_OLAMBDA()) {
+      mark(ts, bin, op->as_lambda.start_op);
+      mark(ts, bin, op->as_lambda.start_op+op->as_lambda.nops);
+    } else if (op->type == CX_OJUMP()) {
+      mark(ts, bin, op->as_jump.pc);
+    } else if (op->type == CX_ORETURN()) {
+      mark(ts, bin, op->as_return.pc);
+      mark(ts, bin, op->as_return.pc+1);
+    }
+  }
+
+  cx_do_set(&bin->fimps, struct cx_bin_fimp, f) {
+    if (f->start_pc >= start_pc) {
+      mark(ts, bin, f->start_pc);
+      mark(ts, bin, f->start_pc+f->nops);
+    }
+  }
+
+  cx_do_set(&cx->lib_lookup, struct cx_lib *, l) {
+    cx_do_vec(&(*l)->inits, struct cx_lib_init, i) {
+      if (i->bin == bin && i->start_pc >= start_pc) {
+	mark(ts, bin, i->start_pc);
+	mark(ts, bin, i->start_pc+i->nops);
+      }
+    }
+  }
+
+  return ts;
+}
+
+static void remove_ops(struct cx *cx,
+		       struct cx_bin *bin,
+		       size_t start_pc,
+		       bool *dead) {
+  size_t n = bin->ops.count, *pcs = malloc((n+1)*sizeof(size_t)), j = start_pc;
+
+  for (size_t i = 0; i <= n; i++) {
+    if (i < start_pc) {
+      pcs[i] = i;
+    } else {
+      pcs[i] = j;
+      if (i < n && !dead[i]) { j++; }
+    }
+  }
+
+  ssize_t skip(size_t i, ssize_t nops) { return pcs[i+1+nops] - pcs[i] - 1; }
+
+  for (size_t i = start_pc; i < n; i++) {
+    struct cx_op *op = cx_vec_get(&bin->ops, i);
+
+    if (dead[i]) {
+      cx_op_deinit(op);
+      continue;
+    }
+
+    if (op->type == CX_OBEGIN()) {
+      op->as_begin.nops = skip(i, op->as_begin.nops);
+    } else if (op->type == CX_OCATCH()) {
+      op->as_catch.nops = skip(i, op->as_catch.nops);
+    } else if (op->type == CX_OELSE()) {
+      op->as_else.nops = skip(i, op->as_else.nops);
+    } else if (op->type == CX_OLAMBDA()) {
+      op->as_lambda.nops = skip(i, op->as_lambda.nops);
+      op->as_lambda.start_op = pcs[i]+1;
+    } else if (op->type == CX_OJUMP()) {
+      op->as_jump.pc = pcs[op->as_jump.pc];
+    } else if (op->type == CX_ORETURN()) {
+      op->as_return.pc = pcs[op->as_return.pc];
+    }
+
+    op->pc = pcs[i];
+    if (op->pc != i) { *(struct cx_op *)cx_vec_get(&bin->ops, op->pc) = *op; }
+  }
+
+  cx_do_set(&bin->fimps, struct cx_bin_fimp, f) {
+    if (f->start_pc >= start_pc) {
+      ssize_t end = pcs[f->start_pc+f->nops];
+      f->start_pc = pcs[f->start_pc];
+      f->nops = end - f->start_pc;
+    }
+  }
+
+  cx_do_set(&cx->lib_lookup, struct cx_lib *, l) {
+    cx_do_vec(&(*l)->inits, struct cx_lib_init, i) {
+      if (i->bin == bin && i->start_pc >= start_pc) {
+	size_t end = pcs[i->start_pc+i->nops];
+	i->start_pc = pcs[i->start_pc];
+	i->nops = end - i->start_pc;
+      }
+    }
+  }
+
+  bin->ops.count = j;
+  if (bin->init_offs > start_pc) { bin->init_offs = start_pc; }
+  cx_vec_clear(&bin->code);
+  free(pcs);
+}
+
+static bool fold_call(struct cx *cx,
+		      struct cx_bin *bin,
+		      struct cx_op *op,
+		      size_t *pushes, size_t *npushes,
+		      bool *dead) {
+  struct cx_func *func = op->as_funcall.func;
+  size_t nargs = func->nargs;
+  if (!nargs || *npushes < nargs) { return false; }
+  size_t *args = pushes + *npushes - nargs;
+  struct cx_scope *s = cx_scope_ref(cx_scope_new(cx, NULL));
+  bool ok = false;
+  
+  for (size_t i = 0; i < nargs; i++) {
+    struct cx_op *a = cx_vec_get(&bin->ops, args[i]);
+    cx_copy(cx_push(s), &a->as_push.value);
+  }
+
+  struct cx_fimp *imp = op->as_funcall.imp;
+  if (imp && !cx_fimp_match(imp, s)) { imp = NULL; }
+  if (!imp) { imp = cx_func_match(func, s); }
+  if (!imp || !imp->pure) { goto exit; }
+  
+  size_t nerrors = cx->errors.count;
+  ok = cx_fimp_call(imp, s) && cx->errors.count == nerrors && s->stack.count <= nargs;
+
+  while (cx->errors.count > nerrors) {
+    cx_error_deref(*(struct cx_error **)cx_vec_pop(&cx->errors));
+  }
+  
+  if (!ok) { goto exit; }
+  struct cx_box *v = cx_vec_start(&s->stack);
+  size_t nrets = s->stack.count;
+  
+  for (size_t i = 0; i < nargs; i++) {
+    struct cx_op *a = cx_vec_get(&bin->ops, args[i]);
+
+    if (i < nrets) {
+      cx_box_deinit(&a->as_push.value);
+      a->as_push.value = *v++;
+    } else {
+      dead[args[i]] = true;
+    }
+  }
+
+  s->stack.count = 0;
+  dead[op->pc] = true;
+  *npushes -= nargs - nrets;
+ exit:
+  cx_scope_deref(s);
+  return ok;
+}
+
+static void fold_consts(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  size_t
+    *ts = cx_find_targets(cx, bin, start_pc),
+    *pushes = malloc(bin->ops.count*sizeof(size_t)),
+    npushes = 0;
+
+  bool *dead = calloc(bin->ops.count, sizeof(bool)), folded = false;
+  
+  for (size_t i = start_pc; i < bin->ops.count; i++) {
+    struct cx_op *op = cx_vec_get(&bin->ops, i);
+    if (ts[i]) { npushes = 0; }
+    
+    if (op->type == CX_OPUSH()) {
+      pushes[npushes++] = i;
+    } else if (op->type == CX_OFUNCALL() &&
+	       fold_call(cx, bin, op, pushes, &npushes, dead)) {
+      cx->peephole.folds++;
+      folded = true;
+    } else {
+      npushes = 0;
+    }
+  }
+
+  if (folded) { remove_ops(cx, bin, start_pc, dead); }
+  free(dead);
+  free(pushes);
+  free(ts);
+}
+
+static bool is_scope(struct cx_op *op) {
+  return op->type == CX_OBEGIN() && op->as_begin.child && !op->as_begin.fimp;
+}
+
+static void drop_scopes(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  size_t *ts = cx_find_targets(cx, bin, start_pc);
+  bool *dead = calloc(bin->ops.count, sizeof(bool));
+  size_t ndead = 0;
+
+  for (size_t i = start_pc; i < bin->ops.count; i++) {
+    struct cx_op *op = cx_vec_get(&bin->ops, i);
+    if (dead[i] || !is_scope(op)) { continue; }
+    size_t end = i+op->as_begin.nops;
+    struct cx_op *end_op = cx_vec_get(&bin->ops, end);
+    if (end_op->type != CX_OEND()) { continue; }
+    struct cx_op *body = op+1;
+
+    if (is_scope(body) && body->as_begin.nops == op->as_begin.nops-2) {
+      if (ts[i+1] || dead[i+1]) { continue; }
+      dead[i+1] = dead[end-1] = true;
+      ndead += 2;
+      cx->peephole.scopes++;
+      continue;
+    }
+
+    bool ok = true;
+
+    for (size_t j = i+1; j <= end; j++) {
+      struct cx_op *bop = cx_vec_get(&bin->ops, j);
+
+      if (ts[j] || (j < end && bop->type != CX_OPUSH())) {
+	ok = false;
+	break;
+      }
+    }
+
+    if (ok) {
+      dead[i] = dead[end] = true;
+      ndead += 2;
+      cx->peephole.scopes++;
+    }
+  }
+
+  if (ndead) { remove_ops(cx, bin, start_pc, dead); }
+  free(dead);
+  free(ts);
+}
+
+static bool fuse_pushcall(struct cx *cx, struct cx_op *op, struct cx_op *call) {
+  if (op->as_push.value.type != cx->int_type) { return false; }
+  struct cx_func *func = call->as_funcall.func;
+
+  struct {
+    const char *lib, *func;
+    enum cx_pushcall_kind kind;
+  } *k, kinds[] = {
+    {"cx/math", "+", CX_PUSHCALL_ADD},
+    {"cx/math", "-", CX_PUSHCALL_SUB},
+    {"cx/math", "*", CX_PUSHCALL_MUL},
+    {"cx/math", "/", CX_PUSHCALL_DIV},
+    {"cx/math", "mod", CX_PUSHCALL_MOD},
+    {"cx/cond", "=", CX_PUSHCALL_EQ},
+    {"cx/cond", "<", CX_PUSHCALL_LT},
+    {"cx/cond", ">", CX_PUSHCALL_GT},
+    {"cx/cond", "<=", CX_PUSHCALL_LTE},
+    {"cx/cond", ">=", CX_PUSHCALL_GTE},
+    {NULL, NULL, 0}
+  };
+
+  for (k = kinds; k->lib; k++) {
+    if (strcmp(func->lib->id.id, k->lib) == 0 && strcmp(func->id, k->func) == 0) {
+      break;
+    }
+  }
+
+  if (!k->lib) { return false; }
+  struct cx_fimp *imp = NULL;
+
+  if (k->kind < CX_PUSHCALL_EQ) {
+    const char *id = "Int Int";
+    struct cx_fimp **found = cx_set_get(&func->imps, &id);
+    if (found) { imp = *found; }
+  } else {
+    cx_do_set(&func->imps, struct cx_fimp *, i) {
+      if ((*i)->lib == func->lib) {
+	imp = *i;
+	break;
+      }
+    }
+  }
+
+  if (!imp || !imp->ptr || imp->lib != func->lib) { return false; }
+  int64_t value = op->as_push.value.as_int;
+  op->type = CX_OPUSHCALL();
+  op->as_pushcall.value = value;
+  op->as_pushcall.imp = imp;
+  op->as_pushcall.kind = k->kind;
+  return true;
+}
+
+static void fuse_ops(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  size_t *ts = cx_find_targets(cx, bin, start_pc);
+
+  for (size_t i = start_pc; i+1 < bin->ops.count; i++) {
+    if (ts[i+1]) { continue; }
+    struct cx_op *op = cx_vec_get(&bin->ops, i), *next = op+1;
+
+    if (op->type == CX_OPUSH()) {
+      if (next->type == CX_OFUNCALL() && fuse_pushcall(cx, op, next)) {
+	cx->peephole.push_calls++;
+	i++;
+      } else if (next->type == CX_OPUTVAR() &&
+		 (!next->as_putvar.type ||
+		  cx_is(op->as_push.value.type, next->as_putvar.type))) {
+	op->type = CX_OPUSHPUT();
+	cx->peephole.push_puts++;
+	i++;
+      }
+    } else if (op->type == CX_OGETVAR() && next->type == CX_OFUNCALL()) {
+      op->type = CX_OGETCALL();
+      cx->peephole.get_calls++;
+      i++;
+    }
+  }
+
+  free(ts);
+}
+
+void cx_peephole(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  if (start_pc >= bin->ops.count) { return; }
+  fold_consts(cx, bin, start_pc);
+  drop_scopes(cx, bin, start_pc);
+  fuse_ops(cx, bin, start_pc);
+}
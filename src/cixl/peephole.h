@@ -0,0 +1,19 @@
+#ifndef CX_PEEPHOLE_H
+#define CX_PEEPHOLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+struct cx;
+struct cx_bin;
+
+struct cx_peephole {
+  bool enabled;
+  size_t folds, push_calls, get_calls, push_puts, scopes;
+};
+
+struct cx_peephole *cx_peephole_init(struct cx_peephole *p);
+void cx_peephole(struct cx *cx, struct cx_bin *bin, size_t start_pc);
+size_t *cx_find_targets(struct cx *cx, struct cx_bin *bin, size_t start_pc);
+
+#endif
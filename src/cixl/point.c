@@ -6,55 +6,86 @@
 #include "cixl/emit.h"
 #include "cixl/error.h"
 #include "cixl/iter.h"
+#include "cixl/malloc.h"
 #include "cixl/scope.h"
 #include "cixl/str.h"
 #include "cixl/int.h"
 #include "cixl/util.h"
 
+struct cx_point *cx_point_new(struct cx *cx, cx_float_t x, cx_float_t y) {
+  struct cx_point *p = cx_point_init(cx_malloc(&cx->point_alloc), x, y);
+  p->cx = cx;
+  return p;
+}
+
 struct cx_point *cx_point_init(struct cx_point *p, cx_float_t x, cx_float_t y) {
+  p->cx = NULL;
   p->x = x;
   p->y = y;
+  p->nrefs = 1;
+  return p;
+}
+
+struct cx_point *cx_point_ref(struct cx_point *p) {
+  p->nrefs++;
   return p;
 }
 
+void cx_point_deref(struct cx_point *p) {
+  cx_test(p->nrefs);
+  p->nrefs--;
+  if (!p->nrefs) { cx_free(&p->cx->point_alloc, p); }
+}
+
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
-  struct cx_point *xp = &x->as_point, *yp = &y->as_point;
+  struct cx_point *xp = x->as_point, *yp = y->as_point;
   return xp->x == yp->x && xp->y == yp->y;
 }
 
 static enum cx_cmp cmp_imp(const struct cx_box *x, const struct cx_box *y) {
-  const struct cx_point *xp = &x->as_point, *yp = &y->as_point; 
-  enum cx_cmp cmp = cx_cmp_float(&xp->x, &yp->x);
+  const struct cx_point *xp = x->as_point, *yp = y->as_point; 
+  cx_float_t xv = xp->x, yv = yp->x;
+  enum cx_cmp cmp = cx_cmp_float(&xv, &yv);
   if (cmp != CX_CMP_EQ) { return cmp; }
-  return cx_cmp_float(&xp->y, &yp->y);
+  xv = xp->y;
+  yv = yp->y;
+  return cx_cmp_float(&xv, &yv);
 }
 
 static bool ok_imp(struct cx_box *v) {
-  struct cx_point *p = &v->as_point;
+  struct cx_point *p = v->as_point;
   return p->x || p->y;
 }
 
+static void copy_imp(struct cx_box *dst, const struct cx_box *src) {
+  dst->as_point = cx_point_ref(src->as_point);
+}
+
 static void dump_imp(struct cx_box *v, FILE *out) {
-  struct cx_point *p = &v->as_point;
+  struct cx_point *p = v->as_point;
   fprintf(out, "Point(%lf %lf)", p->x, p->y);
 }
 
 static void write_imp(struct cx_box *v, FILE *out) {
-  struct cx_point *p = &v->as_point;
+  struct cx_point *p = v->as_point;
   fprintf(out, "(%lf %lf xy)", p->x, p->y);
 }
 
 static bool emit_imp(struct cx_box *v, const char *exp, FILE *out) {
-  struct cx_point *p = &v->as_point;
+  struct cx_point *p = v->as_point;
 
   fprintf(out,
-	  "cx_point_init(&cx_box_init(%s, cx->point_type)->as_point, "
-	  "%lf, %lf);\n",
+	  "cx_box_init(%s, cx->point_type)->as_point = "
+	  "cx_point_new(cx, %lf, %lf);\n",
 	  exp, p->x, p->y);
   
   return true;
 }
 
+static void deinit_imp(struct cx_box *v) {
+  cx_point_deref(v->as_point);
+}
+
 struct cx_type *cx_init_point_type(struct cx_lib *lib) {
   struct cx *cx = lib->cx;
   struct cx_type *t = cx_add_type(lib, "Point", cx->any_type);
@@ -62,8 +93,10 @@ struct cx_type *cx_init_point_type(struct cx_lib *lib) {
   t->equid = equid_imp;
   t->cmp = cmp_imp;
   t->ok = ok_imp;
+  t->copy = copy_imp;
   t->write = write_imp;
   t->dump = dump_imp;
-  t->emit = emit_imp;  
+  t->emit = emit_imp;
+  t->deinit = deinit_imp;
   return t;
 }
@@ -1,14 +1,21 @@
 #ifndef CX_POINT_H
 #define CX_POINT_H
 
+struct cx;
 struct cx_lib;
 struct cx_type;
 
 struct cx_point {
+  struct cx *cx;
   cx_float_t x, y;
+  unsigned int nrefs;
 };
 
+struct cx_point *cx_point_new(struct cx *cx, cx_float_t x, cx_float_t y);
 struct cx_point *cx_point_init(struct cx_point *p, cx_float_t x, cx_float_t y);
+struct cx_point *cx_point_ref(struct cx_point *p);
+void cx_point_deref(struct cx_point *p);
+
 struct cx_type *cx_init_point_type(struct cx_lib *lib);
 
 #endif
@@ -0,0 +1,270 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "cixl/call.h"
+#include "cixl/cx.h"
+#include "cixl/error.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/mfile.h"
+#include "cixl/prof.h"
+#include "cixl/set.h"
+
+static struct cx_prof *active = NULL;
+static struct sigaction prev_action;
+
+struct cx_prof *cx_prof_init(struct cx_prof *p, struct cx *cx) {
+  p->cx = cx;
+  p->samples = NULL;
+  p->frames = NULL;
+  p->nsamples = p->nframes = p->nlost = 0;
+  p->active = false;
+  return p;
+}
+
+struct cx_prof *cx_prof_deinit(struct cx_prof *p) {
+  if (p->active) { cx_prof_stop(p); }
+  if (p->samples) { free(p->samples); }
+  if (p->frames) { free(p->frames); }
+  return p;
+}
+
+static void on_prof(int sig) {
+  struct cx_prof *p = active;
+  if (!p) { return; }
+  struct cx *cx = p->cx;
+  size_t n = cx->ncalls;
+
+  if (p->nsamples == CX_PROF_MAX_SAMPLES ||
+      p->nframes+n > CX_PROF_MAX_FRAMES) {
+    p->nlost++;
+    return;
+  }
+
+  struct cx_prof_sample *s = p->samples + p->nsamples;
+  s->file = cx->file;
+  s->row = cx->row;
+  s->col = cx->col;
+  s->start = p->nframes;
+  s->depth = n;
+
+  for (size_t i = 0; i < n; i++) {
+    p->frames[p->nframes++] = cx->calls[i].fimp;
+  }
+
+  p->nsamples++;
+}
+
+bool cx_prof_start(struct cx_prof *p, int interval) {
+  struct cx *cx = p->cx;
+
+  if (active) {
+    cx_error(cx, cx->row, cx->col, "Profiler already active");
+    return false;
+  }
+
+  if (!p->samples) {
+    p->samples = malloc(sizeof(struct cx_prof_sample)*CX_PROF_MAX_SAMPLES);
+    p->frames = malloc(sizeof(struct cx_fimp *)*CX_PROF_MAX_FRAMES);
+  }
+
+  p->nsamples = p->nframes = p->nlost = 0;
+
+  struct sigaction a;
+  memset(&a, 0, sizeof(a));
+  a.sa_handler = on_prof;
+  a.sa_flags = SA_RESTART;
+  sigemptyset(&a.sa_mask);
+
+  if (sigaction(SIGPROF, &a, &prev_action)) {
+    cx_error(cx, cx->row, cx->col, "Failed installing PROF handler: %d", errno);
+    return false;
+  }
+
+  active = p;
+  p->active = true;
+
+  struct itimerval t;
+  t.it_interval.tv_sec = interval / 1000000;
+  t.it_interval.tv_usec = interval % 1000000;
+  t.it_value = t.it_interval;
+
+  if (setitimer(ITIMER_PROF, &t, NULL)) {
+    cx_error(cx, cx->row, cx->col, "Failed starting timer: %d", errno);
+    cx_prof_stop(p);
+    return false;
+  }
+
+  return true;
+}
+
+bool cx_prof_stop(struct cx_prof *p) {
+  struct cx *cx = p->cx;
+
+  if (!p->active) {
+    cx_error(cx, cx->row, cx->col, "Profiler not active");
+    return false;
+  }
+
+  struct itimerval t;
+  memset(&t, 0, sizeof(t));
+  setitimer(ITIMER_PROF, &t, NULL);
+  sigaction(SIGPROF, &prev_action, NULL);
+  active = NULL;
+  p->active = false;
+  return true;
+}
+
+struct fimp_stats {
+  struct cx_fimp *imp;
+  size_t self, total, last;
+};
+
+struct loc_key {
+  const char *file;
+  int row, col;
+};
+
+struct loc_stats {
+  struct loc_key key;
+  size_t n;
+};
+
+static enum cx_cmp loc_cmp(const void *x, const void *y) {
+  const struct loc_key *xk = x, *yk = y;
+  
+  if (xk->file != yk->file) {
+    if (!xk->file) { return CX_CMP_LT; }
+    if (!yk->file) { return CX_CMP_GT; }
+    enum cx_cmp res = cx_cmp_cstr(&xk->file, &yk->file);
+    if (res != CX_CMP_EQ) { return res; }
+  }
+
+  if (xk->row != yk->row) { return (xk->row < yk->row) ? CX_CMP_LT : CX_CMP_GT; }
+  if (xk->col != yk->col) { return (xk->col < yk->col) ? CX_CMP_LT : CX_CMP_GT; }
+  return CX_CMP_EQ;
+}
+
+static int fimp_order(const void *x, const void *y) {
+  const struct fimp_stats *xs = x, *ys = y;
+  if (xs->self != ys->self) { return (xs->self < ys->self) ? 1 : -1; }
+  return (xs->total < ys->total) - (xs->total > ys->total);
+}
+
+static int loc_order(const void *x, const void *y) {
+  const struct loc_stats *xs = x, *ys = y;
+  return (xs->n < ys->n) - (xs->n > ys->n);
+}
+
+void cx_prof_dump(struct cx_prof *p, FILE *out) {
+  struct cx_set imps, locs;
+  cx_set_init(&imps, sizeof(struct fimp_stats), cx_cmp_ptr);
+  imps.key_offs = offsetof(struct fimp_stats, imp);
+  cx_set_init(&locs, sizeof(struct loc_stats), loc_cmp);
+  locs.key_offs = offsetof(struct loc_stats, key);
+
+  for (size_t i = 0; i < p->nsamples; i++) {
+    struct cx_prof_sample *s = p->samples+i;
+    struct cx_fimp **fs = p->frames+s->start;
+
+    for (size_t j = 0; j < s->depth; j++) {
+      struct fimp_stats *fst = cx_set_get(&imps, fs+j);
+
+      if (!fst) {
+	fst = cx_set_insert(&imps, fs+j);
+	fst->imp = fs[j];
+	fst->self = fst->total = fst->last = 0;
+      }
+
+      if (fst->last != i+1) {
+	fst->total++;
+	fst->last = i+1;
+      }
+
+      if (j == s->depth-1) { fst->self++; }
+    }
+
+    struct loc_key key = {s->file, s->row, s->col};
+    struct loc_stats *l = cx_set_get(&locs, &key);
+
+    if (!l) {
+      l = cx_set_insert(&locs, &key);
+      l->key = key;
+      l->n = 0;
+    }
+
+    l->n++;
+  }
+
+  qsort(imps.members.items, imps.members.count, sizeof(struct fimp_stats),
+	fimp_order);
+  qsort(locs.members.items, locs.members.count, sizeof(struct loc_stats),
+	loc_order);
+
+  fprintf(out, "Samples: %zd, lost: %zd\n\n", p->nsamples, p->nlost);
+  fputs("   Self   Total  Fimp\n", out);
+
+  cx_do_set(&imps, struct fimp_stats, s) {
+    fprintf(out, "%7zd %7zd  %s<%s>\n",
+	    s->self, s->total, s->imp->func->id, s->imp->id);
+  }
+
+  fputs("\nSamples     Row     Col  File\n", out);
+
+  cx_do_set(&locs, struct loc_stats, l) {
+    fprintf(out, "%7zd %7d %7d  %s\n",
+	    l->n, l->key.row, l->key.col, l->key.file ? l->key.file : "?");
+  }
+
+  cx_set_deinit(&imps);
+  cx_set_deinit(&locs);
+}
+
+struct fold_stats {
+  char *stack;
+  size_t n;
+};
+
+void cx_prof_fold(struct cx_prof *p, FILE *out) {
+  struct cx_set stacks;
+  cx_set_init(&stacks, sizeof(struct fold_stats), cx_cmp_cstr);
+  stacks.key_offs = offsetof(struct fold_stats, stack);
+
+  for (struct cx_prof_sample *s = p->samples;
+       s < p->samples+p->nsamples;
+       s++) {
+    struct cx_mfile stack;
+    cx_mfile_open(&stack);
+
+    for (struct cx_fimp **f = p->frames+s->start;
+	 f < p->frames+s->start+s->depth;
+	 f++) {
+      fprintf(stack.stream, "%s<%s>;", (*f)->func->id, (*f)->id);
+    }
+
+    fprintf(stack.stream, "%s:%d:%d", s->file ? s->file : "?", s->row, s->col);
+    cx_mfile_close(&stack);
+    struct fold_stats *fs = cx_set_get(&stacks, &stack.data);
+
+    if (fs) {
+      free(stack.data);
+    } else {
+      fs = cx_set_insert(&stacks, &stack.data);
+      fs->stack = stack.data;
+      fs->n = 0;
+    }
+
+    fs->n++;
+  }
+
+  cx_do_set(&stacks, struct fold_stats, s) {
+    fprintf(out, "%s %zd\n", s->stack, s->n);
+    free(s->stack);
+  }
+
+  cx_set_deinit(&stacks);
+}
@@ -0,0 +1,37 @@
+#ifndef CX_PROF_H
+#define CX_PROF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define CX_PROF_INTERVAL 1000
+#define CX_PROF_MAX_SAMPLES 65536
+#define CX_PROF_MAX_FRAMES 1048576
+
+struct cx;
+struct cx_fimp;
+
+struct cx_prof_sample {
+  size_t start, depth;
+  const char *file;
+  int row, col;
+};
+
+struct cx_prof {
+  struct cx *cx;
+  struct cx_prof_sample *samples;
+  struct cx_fimp **frames;
+  size_t nsamples, nframes, nlost;
+  bool active;
+};
+
+struct cx_prof *cx_prof_init(struct cx_prof *p, struct cx *cx);
+struct cx_prof *cx_prof_deinit(struct cx_prof *p);
+
+bool cx_prof_start(struct cx_prof *p, int interval);
+bool cx_prof_stop(struct cx_prof *p);
+void cx_prof_dump(struct cx_prof *p, FILE *out);
+void cx_prof_fold(struct cx_prof *p, FILE *out);
+
+#endif
@@ -21,13 +21,43 @@ static bool init_emit_bmips(struct cx *cx) {
 bool _eval(struct cx *cx, ssize_t stop_pc) {
   static bool init = true;
 
-  static struct cx_sym sym_b;
   static struct cx_sym sym_n;
   static struct cx_sym sym_a;
+  static struct cx_sym sym_b;
+
+  struct cx_lib *lib_lobby() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "lobby", false)); }
+    return l;
+  }
+
+  struct cx_lib *lib_cxEabc() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/abc", false)); }
+    return l;
+  }
+
+  struct cx_lib *lib_cxEbench() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/bench", false)); }
+    return l;
+  }
+
+  struct cx_lib *lib_cxEcond() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/cond", false)); }
+    return l;
+  }
+
+  struct cx_lib *lib_cxEfunc() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/func", false)); }
+    return l;
+  }
 
-  struct cx_lib *lib_cxEbin() {
+  struct cx_lib *lib_cxEiter() {
     static struct cx_lib *l = NULL;
-    if (!l) { l = cx_test(cx_get_lib(cx, "cx/bin", false)); }
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/iter", false)); }
     return l;
   }
 
@@ -37,81 +67,163 @@ bool _eval(struct cx *cx, ssize_t stop_pc) {
     return l;
   }
 
+  struct cx_lib *lib_cxEstack() {
+    static struct cx_lib *l = NULL;
+    if (!l) { l = cx_test(cx_get_lib(cx, "cx/stack", false)); }
+    return l;
+  }
+
   struct cx_type *type_Int() {
     static struct cx_type *t = NULL;
-    if (!t) { t = cx_test(cx_get_type(cx, "Int", false)); }
+    if (!t) {
+      cx_push_lib(cx, lib_cxEabc());
+      t = cx_test(cx_get_type(cx, "Int", false));
+      cx_pop_lib(cx);
+    }
+
     return t;
   }
 
   struct cx_func *func_A() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "+", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEmath());
+      f = cx_test(cx_get_func(cx, "+", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_NN() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "--", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEmath());
+      f = cx_test(cx_get_func(cx, "--", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_E() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "/", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEmath());
+      f = cx_test(cx_get_func(cx, "/", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_M() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "?", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEcond());
+      f = cx_test(cx_get_func(cx, "?", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func__() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "_", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEstack());
+      f = cx_test(cx_get_func(cx, "_", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
-  struct cx_func *func_clock() {
+  struct cx_func *func_bench() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "clock", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEbench());
+      f = cx_test(cx_get_func(cx, "bench", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_emitNbmips() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "emit-bmips", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_lobby());
+      f = cx_test(cx_get_func(cx, "emit-bmips", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_fib() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "fib", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEmath());
+      f = cx_test(cx_get_func(cx, "fib", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_fibNrec() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "fib-rec", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEmath());
+      f = cx_test(cx_get_func(cx, "fib-rec", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_ifNelse() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "if-else", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEcond());
+      f = cx_test(cx_get_func(cx, "if-else", false));
+      cx_pop_lib(cx);
+    }
+
+    return f;
+  }
+
+  struct cx_func *func_median() {
+    static struct cx_func *f = NULL;
+    if (!f) {
+      cx_push_lib(cx, lib_cxEbench());
+      f = cx_test(cx_get_func(cx, "median", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_recall() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "recall", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEfunc());
+      f = cx_test(cx_get_func(cx, "recall", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
   struct cx_func *func_times() {
     static struct cx_func *f = NULL;
-    if (!f) { f = cx_test(cx_get_func(cx, "times", false)); }
+    if (!f) {
+      cx_push_lib(cx, lib_cxEiter());
+      f = cx_test(cx_get_func(cx, "times", false));
+      cx_pop_lib(cx);
+    }
+
     return f;
   }
 
@@ -121,9 +233,9 @@ bool _eval(struct cx *cx, ssize_t stop_pc) {
     return f;
   }
 
-  struct cx_fimp *func_fib_Int() {
+  struct cx_fimp *func_recall_() {
     static struct cx_fimp *f = NULL;
-    if (!f) { f = cx_test(cx_get_fimp(func_fib(), "Int", false)); }
+    if (!f) { f = cx_test(cx_get_fimp(func_recall(), "", false)); }
     return f;
   }
 
@@ -139,6 +251,12 @@ bool _eval(struct cx *cx, ssize_t stop_pc) {
     return f;
   }
 
+  struct cx_fimp *func_fib_Int() {
+    static struct cx_fimp *f = NULL;
+    if (!f) { f = cx_test(cx_get_fimp(func_fib(), "Int", false)); }
+    return f;
+  }
+
   struct cx_fimp *func_emitNbmips_() {
     static struct cx_fimp *f = NULL;
     if (!f) { f = cx_test(cx_get_fimp(func_emitNbmips(), "", false)); }
@@ -149,143 +267,134 @@ bool _eval(struct cx *cx, ssize_t stop_pc) {
   if (init) {
     init = false;
 
-    sym_b = cx_sym(cx, "b");
     sym_n = cx_sym(cx, "n");
     sym_a = cx_sym(cx, "a");
+    sym_b = cx_sym(cx, "b");
 
-struct cx_arg args97[0] = {
+if (!cx_use(cx, "cx")) { goto op1; }
+struct cx_arg args101[0] = {
 };
 
-struct cx_arg rets98[1] = {
+struct cx_arg rets102[1] = {
 cx_arg(NULL, cx_get_type(cx, "Int", false))};
 
-struct cx_fimp *imp99 = cx_test(cx_add_func(*cx->lib, "emit-bmips", 0, args97, 1, rets98));
-struct cx_bin_fimp *bimp100 = cx_test(cx_set_insert(&cx->bin->fimps, &imp99));
-imp99->bin = cx_bin_ref(cx->bin);
-bimp100->imp = imp99;
-bimp100->start_pc = 2;
-bimp100->nops = 36;
+struct cx_fimp *imp103 = cx_test(cx_add_func(*cx->lib, "emit-bmips", 0, args101, 1, rets102));
+struct cx_bin_fimp *bimp104 = cx_test(cx_set_insert(&cx->bin->fimps, &imp103));
+imp103->bin = cx_bin_ref(cx->bin);
+bimp104->imp = imp103;
+bimp104->start_pc = 3;
+bimp104->nops = 39;
 cx_push_lib(cx, lib_cxEmath());
-struct cx_fimp *imp101 = func_fib_Int();
+struct cx_fimp *imp105 = func_fib_Int();
 cx_pop_lib(cx);
-struct cx_bin_fimp *bimp102 = cx_test(cx_set_insert(&cx->bin->fimps, &imp101));
-bimp102->imp = imp101;
-bimp102->start_pc = 9;
-bimp102->nops = 23;
+struct cx_bin_fimp *bimp106 = cx_test(cx_set_insert(&cx->bin->fimps, &imp105));
+bimp106->imp = imp105;
+bimp106->start_pc = 12;
+bimp106->nops = 23;
 cx_push_lib(cx, lib_cxEmath());
-struct cx_fimp *imp103 = func_fibNrec_IntIntInt();
+struct cx_fimp *imp107 = func_fibNrec_IntIntInt();
 cx_pop_lib(cx);
-struct cx_bin_fimp *bimp104 = cx_test(cx_set_insert(&cx->bin->fimps, &imp103));
-bimp104->imp = imp103;
-bimp104->start_pc = 15;
-bimp104->nops = 15;
+struct cx_bin_fimp *bimp108 = cx_test(cx_set_insert(&cx->bin->fimps, &imp107));
+bimp108->imp = imp107;
+bimp108->start_pc = 18;
+bimp108->nops = 15;
   }
 
-  static void *op_labels[39] = {
-    &&op0, &&op1, &&op2, &&op3, &&op4, &&op5, &&op6, &&op7, &&op8, &&op9, &&op10, &&op11, &&op12, &&op13, &&op14, &&op15, &&op16, &&op17, &&op18, &&op19, &&op20, &&op21, &&op22, &&op23, &&op24, &&op25, &&op26, &&op27, &&op28, &&op29, &&op30, &&op31, &&op32, &&op33, &&op34, &&op35, &&op36, &&op37, &&op38};
+  static void *op_labels[43] = {
+    &&op0, &&op1, &&op2, &&op3, &&op4, &&op5, &&op6, &&op7, &&op8, &&op9, &&op10, &&op11, &&op12, &&op13, &&op14, &&op15, &&op16, &&op17, &&op18, &&op19, &&op20, &&op21, &&op22, &&op23, &&op24, &&op25, &&op26, &&op27, &&op28, &&op29, &&op30, &&op31, &&op32, &&op33, &&op34, &&op35, &&op36, &&op37, &&op38, &&op39, &&op40, &&op41, &&op42};
 
   goto *op_labels[cx->pc];
 
-op0: { /* CX_TMACRO CX_OFUNCDEF */
+op0: { /* CX_TRMACRO CX_OUSE */
+if (stop_pc == 0) { cx->pc = 0; goto exit; }
 cx->pc = 0;
-if (stop_pc == 0) { goto exit; }
-cx->row = 1; cx->col = 5;
+cx->row = 1; cx->col = 4;
+}
+
+op1: { /* CX_TRMACRO CX_OFUNCDEF */
 struct cx_fimp *i = func_emitNbmips_();
 if (!i->scope) { i->scope = cx_scope_ref(cx_scope(cx, 0)); }
 }
 
-op1: { /* CX_TMACRO CX_OFIMP */
-cx->pc = 1;
-if (stop_pc == 1) { goto exit; }
-cx->row = 1; cx->col = 5;
-goto op38;
+op2: { /* CX_TRMACRO CX_OFIMP */
+goto op42;
 }
 
-op2: { /* CX_TMACRO CX_OBEGIN */
-cx->pc = 2;
-if (stop_pc == 2) { goto exit; }
-cx->row = 1; cx->col = 5;
+op3: { /* CX_TRMACRO CX_OBEGIN */
+if (stop_pc == 3) { cx->pc = 3; goto exit; }
 if (cx->errors.count) {
-goto op38;
-} else {
+goto op42;
+}
+else {
 struct cx_scope *parent = func_emitNbmips_()->scope;
 cx_begin(cx, parent);
-cx_push_lib(cx, lib_cxEbin());
+cx_push_lib(cx, lib_lobby());
 struct cx_call *call = cx_test(cx_peek_call(cx));
 cx_scope_deref(call->scope);
 call->scope = cx_scope_ref(cx_scope(cx, 0));
 }
 }
 
-op3: { /* CX_TLITERAL CX_OPUSH */
-cx->pc = 3;
-if (stop_pc == 3) { goto exit; }
-cx->row = 1; cx->col = 39;
-if (!cx->errors.count) {
+op4: { /* CX_TLITERAL CX_OPUSH */
+if (stop_pc == 4) { cx->pc = 4; goto exit; }
+if (cx->errors.count) { goto op7; }
 cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 10000000000;
 }
+
+op5: { /* CX_TLITERAL CX_OPUSH */
+cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 1;
+}
+
+op6: { /* CX_TLITERAL CX_OPUSH */
+cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 3;
 }
 
-op4: { /* CX_TLAMBDA CX_OLAMBDA */
-cx->pc = 4;
-if (stop_pc == 4) { goto exit; }
-cx->row = 1; cx->col = 41;
+op7: { /* CX_TLAMBDA CX_OLAMBDA */
 if (cx->errors.count) {
-goto op35;
-} else {
+goto op38;
+}
+else {
 struct cx_scope *s = cx_scope(cx, 0);
-struct cx_lambda *l = cx_lambda_new(s, 5, 30);
+struct cx_lambda *l = cx_lambda_new(s, 8, 30);
 cx_box_init(cx_push(s), cx->lambda_type)->as_ptr = l;
-goto op35;
+goto op38;
 }
 }
 
-op5: { /* CX_TLITERAL CX_OPUSH */
-cx->pc = 5;
-if (stop_pc == 5) { goto exit; }
-cx->row = 1; cx->col = 44;
-if (!cx->errors.count) {
+op8: { /* CX_TLITERAL CX_OPUSH */
+if (stop_pc == 8) { cx->pc = 8; goto exit; }
+if (cx->errors.count) { goto op9; }
 cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 10;
 }
-}
 
-op6: { /* CX_TLAMBDA CX_OLAMBDA */
-cx->pc = 6;
-if (stop_pc == 6) { goto exit; }
-cx->row = 1; cx->col = 46;
+op9: { /* CX_TLAMBDA CX_OLAMBDA */
 if (cx->errors.count) {
-goto op34;
-} else {
+goto op37;
+}
+else {
 struct cx_scope *s = cx_scope(cx, 0);
-struct cx_lambda *l = cx_lambda_new(s, 7, 27);
+struct cx_lambda *l = cx_lambda_new(s, 10, 27);
 cx_box_init(cx_push(s), cx->lambda_type)->as_ptr = l;
-goto op34;
+goto op37;
 }
 }
 
-op7: { /* CX_TLITERAL CX_OPUSH */
-cx->pc = 7;
-if (stop_pc == 7) { goto exit; }
-cx->row = 1; cx->col = 49;
-if (!cx->errors.count) {
+op10: { /* CX_TLITERAL CX_OPUSH */
+if (stop_pc == 10) { cx->pc = 10; goto exit; }
+if (cx->errors.count) { goto op11; }
 cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 50;
 }
-}
 
-op8: { /* CX_TID CX_OFIMP */
-cx->pc = 8;
-if (stop_pc == 8) { goto exit; }
-cx->row = 1; cx->col = 50;
-goto op32;
+op11: { /* CX_TID CX_OFIMP */
+goto op35;
 }
 
-op9: { /* CX_TID CX_OBEGIN */
-cx->pc = 9;
-if (stop_pc == 9) { goto exit; }
-cx->row = 1; cx->col = 50;
+op12: { /* CX_TID CX_OBEGIN */
+if (stop_pc == 12) { cx->pc = 12; goto exit; }
 if (cx->errors.count) {
-goto op32;
-} else {
+goto op35;
+}
+else {
 struct cx_scope *parent = func_fib_Int()->scope;
 cx_begin(cx, parent);
 cx_push_lib(cx, lib_cxEmath());
@@ -295,63 +404,43 @@ call->scope = cx_scope_ref(cx_scope(cx, 0));
 }
 }
 
-op10: { /* CX_TID CX_OPUTARGS */
-cx->pc = 10;
-if (stop_pc == 10) { goto exit; }
-cx->row = 1; cx->col = 50;
-if (!cx->errors.count) {
+op13: { /* CX_TID CX_OPUTARGS */
+if (stop_pc == 13) { cx->pc = 13; goto exit; }
+if (cx->errors.count) { goto op17; }
 struct cx_call *call = cx_test(cx_peek_call(cx));
 struct cx_box *a = call->args;
 struct cx_scope *s = cx_scope(cx, 0);
 cx_copy(cx_put_var(s, sym_n), a);
 a++;
 }
-}
 
-op11: { /* CX_TLITERAL CX_OPUSH */
-cx->pc = 11;
-if (stop_pc == 11) { goto exit; }
-cx->row = 1; cx->col = 1;
-if (!cx->errors.count) {
+op14: { /* CX_TLITERAL CX_OPUSH */
 cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 0;
 }
-}
 
-op12: { /* CX_TLITERAL CX_OPUSH */
-cx->pc = 12;
-if (stop_pc == 12) { goto exit; }
-cx->row = 1; cx->col = 3;
-if (!cx->errors.count) {
+op15: { /* CX_TLITERAL CX_OPUSH */
 cx_box_init(cx_push(cx_scope(cx, 0)), cx->int_type)->as_int = 1;
 }
-}
 
-op13: { /* CX_TID CX_OGETVAR */
-cx->pc = 13;
-if (stop_pc == 13) { goto exit; }
+op16: { /* CX_TID CX_OGETVAR */
+cx->pc = 16;
 cx->row = 1; cx->col = 4;
-if (!cx->errors.count) {
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_n, false);
-if (!v) { goto op14; }
+if (!v) { goto op17; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op14: { /* CX_TID CX_OFIMP */
-cx->pc = 14;
-if (stop_pc == 14) { goto exit; }
-cx->row = 1; cx->col = 7;
-goto op30;
+op17: { /* CX_TID CX_OFIMP */
+goto op33;
 }
 
-op15: { /* CX_TID CX_OBEGIN */
-cx->pc = 15;
-if (stop_pc == 15) { goto exit; }
-cx->row = 1; cx->col = 7;
+op18: { /* CX_TID CX_OBEGIN */
+if (stop_pc == 18) { cx->pc = 18; goto exit; }
 if (cx->errors.count) {
-goto op30;
-} else {
+goto op33;
+}
+else {
 struct cx_scope *parent = func_fibNrec_IntIntInt()->scope;
 cx_begin(cx, parent);
 cx_push_lib(cx, lib_cxEmath());
@@ -361,11 +450,9 @@ call->scope = cx_scope_ref(cx_scope(cx, 0));
 }
 }
 
-op16: { /* CX_TID CX_OPUTARGS */
-cx->pc = 16;
-if (stop_pc == 16) { goto exit; }
-cx->row = 1; cx->col = 7;
-if (!cx->errors.count) {
+op19: { /* CX_TID CX_OPUTARGS */
+if (stop_pc == 19) { cx->pc = 19; goto exit; }
+if (cx->errors.count) { goto op22; }
 struct cx_call *call = cx_test(cx_peek_call(cx));
 struct cx_box *a = call->args;
 struct cx_scope *s = cx_scope(cx, 0);
@@ -376,200 +463,210 @@ a++;
 cx_copy(cx_put_var(s, sym_n), a);
 a++;
 }
-}
 
-op17: { /* CX_TID CX_OGETVAR */
-cx->pc = 17;
-if (stop_pc == 17) { goto exit; }
+op20: { /* CX_TID CX_OGETCALL */
+cx->pc = 20;
 cx->row = 1; cx->col = 0;
-if (!cx->errors.count) {
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_n, false);
-if (!v) { goto op18; }
+if (!v) { goto op21; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op18: { /* CX_TID CX_OFUNCALL */
-cx->pc = 18;
-if (stop_pc == 18) { goto exit; }
+op21: { /* CX_TID CX_OFUNCALL */
+cx->pc = 21;
 cx->row = 1; cx->col = 2;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op22; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp105 = NULL;
-if (!imp105) { imp105 = func_M_Opt(); }
-if (imp105 && s->safe && !cx_fimp_match(imp105, s)) { imp105 = NULL; }
-if (!imp105) { imp105 = cx_func_match(func_M(), s); }
+if (s->stack.count >= 1) {
+struct cx_box *xs = (struct cx_box *)cx_vec_end(&s->stack)-1;
+if (xs[0].type == cx->int_type) {
+if (!cx_fimp_call(func_M_Opt(), s)) { goto op22; }
+goto op22;
+}
+}
+
+static struct cx_fimp *imp109 = NULL;
+if (!imp109) { imp109 = func_M_Opt(); }
+if (imp109 && s->safe && !cx_fimp_match(imp109, s)) { imp109 = NULL; }
+if (!imp109) { imp109 = cx_func_match(func_M(), s); }
 
-if (!imp105) {
+if (!imp109) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: ?");
-  goto op19;
+  goto op22;
 }
 
-if (!cx_fimp_call(imp105, s)) { goto op19; }
-}
+if (!cx_fimp_call(imp109, s)) { goto op22; }
 }
 
-op19: { /* CX_TLAMBDA CX_OLAMBDA */
-cx->pc = 19;
-if (stop_pc == 19) { goto exit; }
-cx->row = 1; cx->col = 10;
+op22: { /* CX_TLAMBDA CX_OLAMBDA */
 if (cx->errors.count) {
-goto op27;
-} else {
+goto op30;
+}
+else {
 struct cx_scope *s = cx_scope(cx, 0);
-struct cx_lambda *l = cx_lambda_new(s, 20, 7);
+struct cx_lambda *l = cx_lambda_new(s, 23, 7);
 cx_box_init(cx_push(s), cx->lambda_type)->as_ptr = l;
-goto op27;
+goto op30;
 }
 }
 
-op20: { /* CX_TID CX_OGETVAR */
-cx->pc = 20;
-if (stop_pc == 20) { goto exit; }
+op23: { /* CX_TID CX_OGETVAR */
+if (stop_pc == 23) { cx->pc = 23; goto exit; }
+cx->pc = 23;
 cx->row = 1; cx->col = 11;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_b, false);
-if (!v) { goto op21; }
+if (!v) { goto op24; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op21: { /* CX_TID CX_OGETVAR */
-cx->pc = 21;
-if (stop_pc == 21) { goto exit; }
+op24: { /* CX_TID CX_OGETVAR */
+cx->pc = 24;
 cx->row = 1; cx->col = 14;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_a, false);
-if (!v) { goto op22; }
+if (!v) { goto op25; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op22: { /* CX_TID CX_OGETVAR */
-cx->pc = 22;
-if (stop_pc == 22) { goto exit; }
+op25: { /* CX_TID CX_OGETCALL */
+cx->pc = 25;
 cx->row = 1; cx->col = 17;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_b, false);
-if (!v) { goto op23; }
+if (!v) { goto op26; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op23: { /* CX_TID CX_OFUNCALL */
-cx->pc = 23;
-if (stop_pc == 23) { goto exit; }
+op26: { /* CX_TID CX_OFUNCALL */
+cx->pc = 26;
 cx->row = 1; cx->col = 20;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp106 = NULL;
-if (!imp106) { imp106 = func_A_IntInt(); }
-if (imp106 && s->safe && !cx_fimp_match(imp106, s)) { imp106 = NULL; }
-if (!imp106) { imp106 = cx_func_match(func_A(), s); }
+if (s->stack.count >= 2) {
+struct cx_box *xs = (struct cx_box *)cx_vec_end(&s->stack)-2;
+if (xs[0].type == cx->int_type && xs[1].type == cx->int_type) {
+int64_t x = xs[0].as_int, y = xs[1].as_int;
+s->stack.count--;
+cx_box_init(xs, cx->int_type)->as_int = x+y;
+goto op27;
+}
+}
+
+static struct cx_fimp *imp110 = NULL;
+if (!imp110) { imp110 = func_A_IntInt(); }
+if (imp110 && s->safe && !cx_fimp_match(imp110, s)) { imp110 = NULL; }
+if (!imp110) { imp110 = cx_func_match(func_A(), s); }
 
-if (!imp106) {
+if (!imp110) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: +");
-  goto op24;
+  goto op27;
 }
 
-if (!cx_fimp_call(imp106, s)) { goto op24; }
-}
+if (!cx_fimp_call(imp110, s)) { goto op27; }
 }
 
-op24: { /* CX_TID CX_OGETVAR */
-cx->pc = 24;
-if (stop_pc == 24) { goto exit; }
+op27: { /* CX_TID CX_OGETCALL */
+cx->pc = 27;
 cx->row = 1; cx->col = 31;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_n, false);
-if (!v) { goto op25; }
+if (!v) { goto op28; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op25: { /* CX_TID CX_OFUNCALL */
-cx->pc = 25;
-if (stop_pc == 25) { goto exit; }
+op28: { /* CX_TID CX_OFUNCALL */
+cx->pc = 28;
 cx->row = 1; cx->col = 34;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp107 = NULL;
-if (imp107 && s->safe && !cx_fimp_match(imp107, s)) { imp107 = NULL; }
-if (!imp107) { imp107 = cx_func_match(func_NN(), s); }
+if (s->stack.count >= 1) {
+struct cx_box *xs = (struct cx_box *)cx_vec_end(&s->stack)-1;
+if (xs[0].type == cx->int_type) {
+int64_t x = xs[0].as_int;
+cx_box_init(xs, cx->int_type)->as_int = x-1;
+goto op29;
+}
+}
 
-if (!imp107) {
+static struct cx_fimp *imp111 = NULL;
+if (imp111 && s->safe && !cx_fimp_match(imp111, s)) { imp111 = NULL; }
+if (!imp111) { imp111 = cx_func_match(func_NN(), s); }
+
+if (!imp111) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: --");
-  goto op26;
+  goto op29;
 }
 
-if (!cx_fimp_call(imp107, s)) { goto op26; }
-}
+if (!cx_fimp_call(imp111, s)) { goto op29; }
 }
 
-op26: { /* CX_TID CX_OFUNCALL */
-cx->pc = 26;
-if (stop_pc == 26) { goto exit; }
+op29: { /* CX_TID CX_OFUNCALL */
+cx->pc = 29;
 cx->row = 1; cx->col = 37;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op30; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp108 = NULL;
-if (imp108 && s->safe && !cx_fimp_match(imp108, s)) { imp108 = NULL; }
-if (!imp108) { imp108 = cx_func_match(func_recall(), s); }
+{
+{
+if (!cx_fimp_call(func_recall_(), s)) { goto op30; }
+goto op30;
+}
+}
+
+static struct cx_fimp *imp112 = NULL;
+if (imp112 && s->safe && !cx_fimp_match(imp112, s)) { imp112 = NULL; }
+if (!imp112) { imp112 = cx_func_match(func_recall(), s); }
 
-if (!imp108) {
+if (!imp112) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: recall");
-  goto op27;
+  goto op30;
 }
 
-if (!cx_fimp_call(imp108, s)) { goto op27; }
-}
+if (!cx_fimp_call(imp112, s)) { goto op30; }
 }
 
-op27: { /* CX_TID CX_OGETVAR */
-cx->pc = 27;
-if (stop_pc == 27) { goto exit; }
+op30: { /* CX_TID CX_OGETCALL */
+if (stop_pc == 30) { cx->pc = 30; goto exit; }
+cx->pc = 30;
 cx->row = 1; cx->col = 45;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op32; }
 struct cx_scope *s = cx_scope(cx, 0);
 struct cx_box *v = cx_get_var(s, sym_a, false);
-if (!v) { goto op28; }
+if (!v) { goto op31; }
 cx_copy(cx_push(s), v);
 }
-}
 
-op28: { /* CX_TID CX_OFUNCALL */
-cx->pc = 28;
-if (stop_pc == 28) { goto exit; }
+op31: { /* CX_TID CX_OFUNCALL */
+cx->pc = 31;
 cx->row = 1; cx->col = 48;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op32; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp109 = NULL;
-if (imp109 && s->safe && !cx_fimp_match(imp109, s)) { imp109 = NULL; }
-if (!imp109) { imp109 = cx_func_match(func_ifNelse(), s); }
+static struct cx_fimp *imp113 = NULL;
+if (imp113 && s->safe && !cx_fimp_match(imp113, s)) { imp113 = NULL; }
+if (!imp113) { imp113 = cx_func_match(func_ifNelse(), s); }
 
-if (!imp109) {
+if (!imp113) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: if-else");
-  goto op29;
+  goto op32;
 }
 
-if (!cx_fimp_call(imp109, s)) { goto op29; }
-}
+if (!cx_fimp_call(imp113, s)) { goto op32; }
 }
 
-op29: { /* CX_TID CX_ORETURN */
-cx->pc = 29;
-if (stop_pc == 29) { goto exit; }
+op32: { /* CX_TID CX_ORETURN */
+cx->pc = 32;
 cx->row = 1; cx->col = 7;
 if (cx->errors.count) {
 cx_end(cx);
 cx_pop_lib(cx);
-if (!cx_pop_call(cx)) { goto op30; }
-} else {
+if (!cx_pop_call(cx)) { goto op33; }
+}
+else {
 struct cx_fimp *imp = func_fibNrec_IntIntInt();
 struct cx_call *call = cx_test(cx_peek_call(cx));
 struct cx_scope *s = cx_scope(cx, 0);
@@ -577,13 +674,13 @@ struct cx_scope *s = cx_scope(cx, 0);
 if (call->recalls) {
   if (s->safe && !cx_fimp_match(imp, s)) {
     cx_error(cx, cx->row, cx->col, "Recall not applicable");
-    goto op30;
+    goto op33;
   }
 
   call->recalls--;
   cx_call_deinit_args(call);
   cx_call_pop_args(call);
-  goto op16;
+  goto op19;
 } else {
   size_t si = 0;
 struct cx_type *get_imp_arg(int i) {
@@ -604,7 +701,7 @@ struct cx_type *get_arg(int i) {
     struct cx_box v;
     if (si == s->stack.count) {
       cx_error(cx, cx->row, cx->col, "Not enough return values on stack");
-      goto op30;
+      goto op33;
     }
 
     v = *(struct cx_box *)cx_vec_get(&s->stack, si++);
@@ -616,7 +713,7 @@ struct cx_type *get_arg(int i) {
                  "Invalid return type.\n"
                  "Expected %s, actual: %s",
                  t->id, v.type->id);
-        goto op30;
+        goto op33;
       }
     }
 
@@ -625,45 +722,44 @@ struct cx_type *get_arg(int i) {
 
   if (si < s->stack.count) {
     cx_error(cx, cx->row, cx->col, "Stack not empty on return");
-    goto op30;
+    goto op33;
   }
 
   cx_vec_clear(&s->stack);
   cx_end(cx);
   cx_pop_lib(cx);
-  if (!cx_pop_call(cx)) { goto op30; }
+  if (!cx_pop_call(cx)) { goto op33; }
 }
 }
 }
 
-op30: { /* CX_TID CX_OFUNCALL */
-cx->pc = 30;
-if (stop_pc == 30) { goto exit; }
+op33: { /* CX_TID CX_OFUNCALL */
+if (stop_pc == 33) { cx->pc = 33; goto exit; }
+cx->pc = 33;
 cx->row = 1; cx->col = 7;
-if (!cx->errors.count) {
+if (cx->errors.count) { goto op34; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp110 = NULL;
-if (imp110 && s->safe && !cx_fimp_match(imp110, s)) { imp110 = NULL; }
-if (!imp110) { imp110 = cx_func_match(func_fibNrec(), s); }
+static struct cx_fimp *imp114 = NULL;
+if (imp114 && s->safe && !cx_fimp_match(imp114, s)) { imp114 = NULL; }
+if (!imp114) { imp114 = cx_func_match(func_fibNrec(), s); }
 
-if (!imp110) {
+if (!imp114) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: fib-rec");
-  goto op31;
+  goto op34;
 }
 
-if (!cx_fimp_call(imp110, s)) { goto op31; }
-}
+if (!cx_fimp_call(imp114, s)) { goto op34; }
 }
 
-op31: { /* CX_TID CX_ORETURN */
-cx->pc = 31;
-if (stop_pc == 31) { goto exit; }
-cx->row = 1; cx->col = 50;
+op34: { /* CX_TID CX_ORETURN */
+cx->pc = 34;
+cx->row = 3; cx->col = 28;
 if (cx->errors.count) {
 cx_end(cx);
 cx_pop_lib(cx);
-if (!cx_pop_call(cx)) { goto op32; }
-} else {
+if (!cx_pop_call(cx)) { goto op35; }
+}
+else {
 struct cx_fimp *imp = func_fib_Int();
 struct cx_call *call = cx_test(cx_peek_call(cx));
 struct cx_scope *s = cx_scope(cx, 0);
@@ -671,13 +767,13 @@ struct cx_scope *s = cx_scope(cx, 0);
 if (call->recalls) {
   if (s->safe && !cx_fimp_match(imp, s)) {
     cx_error(cx, cx->row, cx->col, "Recall not applicable");
-    goto op32;
+    goto op35;
   }
 
   call->recalls--;
   cx_call_deinit_args(call);
   cx_call_pop_args(call);
-  goto op10;
+  goto op13;
 } else {
   size_t si = 0;
 struct cx_type *get_imp_arg(int i) {
@@ -698,7 +794,7 @@ struct cx_type *get_arg(int i) {
     struct cx_box v;
     if (si == s->stack.count) {
       cx_error(cx, cx->row, cx->col, "Not enough return values on stack");
-      goto op32;
+      goto op35;
     }
 
     v = *(struct cx_box *)cx_vec_get(&s->stack, si++);
@@ -710,7 +806,7 @@ struct cx_type *get_arg(int i) {
                  "Invalid return type.\n"
                  "Expected %s, actual: %s",
                  t->id, v.type->id);
-        goto op32;
+        goto op35;
       }
     }
 
@@ -719,121 +815,131 @@ struct cx_type *get_arg(int i) {
 
   if (si < s->stack.count) {
     cx_error(cx, cx->row, cx->col, "Stack not empty on return");
-    goto op32;
+    goto op35;
   }
 
   cx_vec_clear(&s->stack);
   cx_end(cx);
   cx_pop_lib(cx);
-  if (!cx_pop_call(cx)) { goto op32; }
+  if (!cx_pop_call(cx)) { goto op35; }
 }
 }
 }
 
-op32: { /* CX_TID CX_OFUNCALL */
-cx->pc = 32;
-if (stop_pc == 32) { goto exit; }
-cx->row = 1; cx->col = 50;
-if (!cx->errors.count) {
+op35: { /* CX_TID CX_OFUNCALL */
+if (stop_pc == 35) { cx->pc = 35; goto exit; }
+cx->pc = 35;
+cx->row = 3; cx->col = 28;
+if (cx->errors.count) { goto op37; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp111 = NULL;
-if (imp111 && s->safe && !cx_fimp_match(imp111, s)) { imp111 = NULL; }
-if (!imp111) { imp111 = cx_func_match(func_fib(), s); }
+static struct cx_fimp *imp115 = NULL;
+if (imp115 && s->safe && !cx_fimp_match(imp115, s)) { imp115 = NULL; }
+if (!imp115) { imp115 = cx_func_match(func_fib(), s); }
 
-if (!imp111) {
+if (!imp115) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: fib");
-  goto op33;
+  goto op36;
 }
 
-if (!cx_fimp_call(imp111, s)) { goto op33; }
-}
+if (!cx_fimp_call(imp115, s)) { goto op36; }
 }
 
-op33: { /* CX_TID CX_OFUNCALL */
-cx->pc = 33;
-if (stop_pc == 33) { goto exit; }
-cx->row = 1; cx->col = 54;
-if (!cx->errors.count) {
+op36: { /* CX_TID CX_OFUNCALL */
+cx->pc = 36;
+cx->row = 3; cx->col = 32;
+if (cx->errors.count) { goto op37; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp112 = NULL;
-if (imp112 && s->safe && !cx_fimp_match(imp112, s)) { imp112 = NULL; }
-if (!imp112) { imp112 = cx_func_match(func__(), s); }
+static struct cx_fimp *imp116 = NULL;
+if (imp116 && s->safe && !cx_fimp_match(imp116, s)) { imp116 = NULL; }
+if (!imp116) { imp116 = cx_func_match(func__(), s); }
 
-if (!imp112) {
+if (!imp116) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: _");
-  goto op34;
+  goto op37;
 }
 
-if (!cx_fimp_call(imp112, s)) { goto op34; }
-}
+if (!cx_fimp_call(imp116, s)) { goto op37; }
 }
 
-op34: { /* CX_TID CX_OFUNCALL */
-cx->pc = 34;
-if (stop_pc == 34) { goto exit; }
-cx->row = 1; cx->col = 57;
-if (!cx->errors.count) {
+op37: { /* CX_TID CX_OFUNCALL */
+if (stop_pc == 37) { cx->pc = 37; goto exit; }
+cx->pc = 37;
+cx->row = 3; cx->col = 35;
+if (cx->errors.count) { goto op38; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp113 = NULL;
-if (imp113 && s->safe && !cx_fimp_match(imp113, s)) { imp113 = NULL; }
-if (!imp113) { imp113 = cx_func_match(func_times(), s); }
+static struct cx_fimp *imp117 = NULL;
+if (imp117 && s->safe && !cx_fimp_match(imp117, s)) { imp117 = NULL; }
+if (!imp117) { imp117 = cx_func_match(func_times(), s); }
 
-if (!imp113) {
+if (!imp117) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: times");
-  goto op35;
+  goto op38;
 }
 
-if (!cx_fimp_call(imp113, s)) { goto op35; }
-}
+if (!cx_fimp_call(imp117, s)) { goto op38; }
 }
 
-op35: { /* CX_TID CX_OFUNCALL */
-cx->pc = 35;
-if (stop_pc == 35) { goto exit; }
-cx->row = 1; cx->col = 64;
-if (!cx->errors.count) {
+op38: { /* CX_TID CX_OFUNCALL */
+if (stop_pc == 38) { cx->pc = 38; goto exit; }
+cx->pc = 38;
+cx->row = 3; cx->col = 42;
+if (cx->errors.count) { goto op41; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp114 = NULL;
-if (imp114 && s->safe && !cx_fimp_match(imp114, s)) { imp114 = NULL; }
-if (!imp114) { imp114 = cx_func_match(func_clock(), s); }
+static struct cx_fimp *imp118 = NULL;
+if (imp118 && s->safe && !cx_fimp_match(imp118, s)) { imp118 = NULL; }
+if (!imp118) { imp118 = cx_func_match(func_bench(), s); }
 
-if (!imp114) {
-  cx_error(cx, cx->row, cx->col, "Func not applicable: clock");
-  goto op36;
+if (!imp118) {
+  cx_error(cx, cx->row, cx->col, "Func not applicable: bench");
+  goto op39;
+}
+
+if (!cx_fimp_call(imp118, s)) { goto op39; }
 }
 
-if (!cx_fimp_call(imp114, s)) { goto op36; }
+op39: { /* CX_TID CX_OFUNCALL */
+cx->pc = 39;
+cx->row = 3; cx->col = 48;
+if (cx->errors.count) { goto op41; }
+struct cx_scope *s = cx_scope(cx, 0);
+static struct cx_fimp *imp119 = NULL;
+if (imp119 && s->safe && !cx_fimp_match(imp119, s)) { imp119 = NULL; }
+if (!imp119) { imp119 = cx_func_match(func_median(), s); }
+
+if (!imp119) {
+  cx_error(cx, cx->row, cx->col, "Func not applicable: median");
+  goto op40;
 }
+
+if (!cx_fimp_call(imp119, s)) { goto op40; }
 }
 
-op36: { /* CX_TID CX_OFUNCALL */
-cx->pc = 36;
-if (stop_pc == 36) { goto exit; }
-cx->row = 1; cx->col = 70;
-if (!cx->errors.count) {
+op40: { /* CX_TID CX_OFUNCALL */
+cx->pc = 40;
+cx->row = 3; cx->col = 55;
+if (cx->errors.count) { goto op41; }
 struct cx_scope *s = cx_scope(cx, 0);
-static struct cx_fimp *imp115 = NULL;
-if (imp115 && s->safe && !cx_fimp_match(imp115, s)) { imp115 = NULL; }
-if (!imp115) { imp115 = cx_func_match(func_E(), s); }
+static struct cx_fimp *imp120 = NULL;
+if (imp120 && s->safe && !cx_fimp_match(imp120, s)) { imp120 = NULL; }
+if (!imp120) { imp120 = cx_func_match(func_E(), s); }
 
-if (!imp115) {
+if (!imp120) {
   cx_error(cx, cx->row, cx->col, "Func not applicable: /");
-  goto op37;
+  goto op41;
 }
 
-if (!cx_fimp_call(imp115, s)) { goto op37; }
-}
+if (!cx_fimp_call(imp120, s)) { goto op41; }
 }
 
-op37: { /* CX_TMACRO CX_ORETURN */
-cx->pc = 37;
-if (stop_pc == 37) { goto exit; }
-cx->row = 1; cx->col = 5;
+op41: { /* CX_TRMACRO CX_ORETURN */
+cx->pc = 41;
+cx->row = 2; cx->col = 5;
 if (cx->errors.count) {
 cx_end(cx);
 cx_pop_lib(cx);
-if (!cx_pop_call(cx)) { goto op38; }
-} else {
+if (!cx_pop_call(cx)) { goto op42; }
+}
+else {
 struct cx_fimp *imp = func_emitNbmips_();
 struct cx_call *call = cx_test(cx_peek_call(cx));
 struct cx_scope *s = cx_scope(cx, 0);
@@ -841,13 +947,13 @@ struct cx_scope *s = cx_scope(cx, 0);
 if (call->recalls) {
   if (s->safe && !cx_fimp_match(imp, s)) {
     cx_error(cx, cx->row, cx->col, "Recall not applicable");
-    goto op38;
+    goto op42;
   }
 
   call->recalls--;
   cx_call_deinit_args(call);
   cx_call_pop_args(call);
-  goto op3;
+  goto op4;
 } else {
   size_t si = 0;
 struct cx_type *get_imp_arg(int i) {
@@ -868,7 +974,7 @@ struct cx_type *get_arg(int i) {
     struct cx_box v;
     if (si == s->stack.count) {
       cx_error(cx, cx->row, cx->col, "Not enough return values on stack");
-      goto op38;
+      goto op42;
     }
 
     v = *(struct cx_box *)cx_vec_get(&s->stack, si++);
@@ -880,7 +986,7 @@ struct cx_type *get_arg(int i) {
                  "Invalid return type.\n"
                  "Expected %s, actual: %s",
                  t->id, v.type->id);
-        goto op38;
+        goto op42;
       }
     }
 
@@ -889,18 +995,18 @@ struct cx_type *get_arg(int i) {
 
   if (si < s->stack.count) {
     cx_error(cx, cx->row, cx->col, "Stack not empty on return");
-    goto op38;
+    goto op42;
   }
 
   cx_vec_clear(&s->stack);
   cx_end(cx);
   cx_pop_lib(cx);
-  if (!cx_pop_call(cx)) { goto op38; }
+  if (!cx_pop_call(cx)) { goto op42; }
 }
 }
 }
 
- op38:
+ op42:
 exit:
   return !cx->errors.count;
 }
@@ -919,7 +1025,7 @@ void cx_repl(struct cx *cx, FILE *in, FILE *out) {
 
   cx_eval_str(cx,
 	      "func: bmips()(_ Int)\n"
-	      "  10000000000 {10 {50 fib _} times} clock /;\n"
+	      "  10000000000 1 3 {10 {50 fib _} times} bench median /;\n"
 	      "[bmips @/ emit-bmips ' bmips' @@n] say");
 
   fputs("Press Return twice to evaluate.\n\n", out);
@@ -3,15 +3,19 @@
 #include "cixl/error.h"
 #include "cixl/scope.h"
 #include "cixl/stack.h"
+#include "cixl/stats.h"
 #include "cixl/tok.h"
 
 struct cx_scope *cx_scope_new(struct cx *cx, struct cx_scope *parent) {
   struct cx_scope *scope = cx_malloc(&cx->scope_alloc);
+  cx_stat(cx->nscopes++);
   scope->cx = cx;
   scope->parent = parent ? cx_scope_ref(parent) : NULL;
   cx_vec_init(&scope->stack, sizeof(struct cx_box));
   scope->stack.alloc = &cx->stack_items_alloc;
   cx_env_init(&scope->vars, &cx->var_alloc);
+  cx_vec_init(&scope->slots, sizeof(struct cx_var));
+  scope->slots.alloc = &cx->slot_items_alloc;
   scope->safe = cx->scopes.count ? cx_scope(cx, 0)->safe : true;
   scope->nrefs = 0;
   return scope;
@@ -27,7 +31,8 @@ void cx_scope_deref(struct cx_scope *scope) {
   scope->nrefs--;
   
   if (!scope->nrefs) {    
-    cx_env_deinit(&scope->vars);
+    cx_clear_vars(scope);
+    cx_vec_deinit(&scope->slots);
 
     cx_do_vec(&scope->stack, struct cx_box, b) { cx_box_deinit(b); }
     cx_vec_deinit(&scope->stack);
@@ -38,6 +43,7 @@ void cx_scope_deref(struct cx_scope *scope) {
 }
 
 struct cx_box *cx_push(struct cx_scope *scope) {
+  cx_stat(scope->cx->npushes++);
   return cx_vec_push(&scope->stack);
 }
 
@@ -62,9 +68,18 @@ struct cx_box *cx_peek(struct cx_scope *scope, bool silent) {
   return cx_vec_peek(&scope->stack, 0);
 }
 
-struct cx_box *cx_get_var(struct cx_scope *scope, struct cx_sym id, bool silent) {
-  struct cx_var *v = cx_env_get(&scope->vars, id);
+static struct cx_var *find_slot(struct cx_scope *scope, struct cx_sym id) {
+  cx_do_vec(&scope->slots, struct cx_var, v) {
+    if (v->value.type && v->id.tag == id.tag) { return v; }
+  }
+
+  return NULL;
+}
 
+struct cx_box *cx_get_var(struct cx_scope *scope, struct cx_sym id, bool silent) {
+  struct cx_var *v = scope->slots.count ? find_slot(scope, id) : NULL;
+  if (!v) { v = cx_env_get(&scope->vars, id); }
+  
   if (!v) {
     if (scope->parent) { return cx_get_var(scope->parent, id, silent); }
 
@@ -80,8 +95,9 @@ struct cx_box *cx_get_var(struct cx_scope *scope, struct cx_sym id, bool silent)
 }
 
 struct cx_box *cx_put_var(struct cx_scope *scope, struct cx_sym id) {
-  struct cx_var *v = cx_env_get(&scope->vars, id);
-
+  struct cx_var *v = scope->slots.count ? find_slot(scope, id) : NULL;
+  if (!v) { v = cx_env_get(&scope->vars, id); }
+  
   if (v) {
     cx_box_deinit(&v->value);
     return &v->value;
@@ -90,6 +106,52 @@ struct cx_box *cx_put_var(struct cx_scope *scope, struct cx_sym id) {
   return cx_env_put(&scope->vars, id);
 }
 
+void cx_clear_vars(struct cx_scope *scope) {
+  cx_env_clear(&scope->vars);
+
+  cx_do_vec(&scope->slots, struct cx_var, v) {
+    if (v->value.type) { cx_box_deinit(&v->value); }
+  }
+
+  cx_vec_clear(&scope->slots);
+}
+
+struct cx_box *cx_get_slot(struct cx_scope *scope,
+			   unsigned int depth, size_t slot,
+			   struct cx_sym id,
+			   bool silent) {
+  while (depth--) { scope = scope->parent; }
+
+  if (slot < scope->slots.count) {
+    struct cx_var *v = cx_vec_get(&scope->slots, slot);
+    if (v->value.type) { return &v->value; }
+  }
+
+  // Slots are only set once their let: has run, anything else is looked up
+  // the slow way to get shadowing and error reporting right.
+  
+  return cx_get_var(scope, id, silent);
+}
+
+struct cx_box *cx_put_slot(struct cx_scope *scope, size_t slot, struct cx_sym id) {
+  struct cx_vec *ss = &scope->slots;
+  
+  if (slot >= ss->count) {
+    cx_vec_grow(ss, slot+1);
+    
+    for (size_t i = ss->count; i <= slot; i++) {
+      ((struct cx_var *)cx_vec_get(ss, i))->value.type = NULL;
+    }
+
+    ss->count = slot+1;
+  }
+
+  struct cx_var *v = cx_vec_get(ss, slot);
+  if (v->value.type) { cx_box_deinit(&v->value); }
+  v->id = id;
+  return &v->value;
+}
+
 void cx_stash(struct cx_scope *s) {
   struct cx *cx = s->cx;
   struct cx_stack *out = cx_stack_new(cx);
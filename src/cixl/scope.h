@@ -13,6 +13,7 @@ struct cx_scope {
   struct cx_scope *parent;
   struct cx_vec stack;
   struct cx_env vars;
+  struct cx_vec slots;
   
   bool safe;
   unsigned int nrefs;
@@ -28,6 +29,14 @@ struct cx_box *cx_peek(struct cx_scope *scope, bool silent);
 
 struct cx_box *cx_get_var(struct cx_scope *scope, struct cx_sym id, bool silent);
 struct cx_box *cx_put_var(struct cx_scope *scope, struct cx_sym id);
+void cx_clear_vars(struct cx_scope *scope);
+
+struct cx_box *cx_get_slot(struct cx_scope *scope,
+			   unsigned int depth, size_t slot,
+			   struct cx_sym id,
+			   bool silent);
+
+struct cx_box *cx_put_slot(struct cx_scope *scope, size_t slot, struct cx_sym id);
 
 void cx_stash(struct cx_scope *s);
 void cx_reset(struct cx_scope *s);
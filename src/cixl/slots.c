@@ -0,0 +1,141 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "cixl/arg.h"
+#include "cixl/bin.h"
+#include "cixl/cx.h"
+#include "cixl/fimp.h"
+#include "cixl/func.h"
+#include "cixl/lib.h"
+#include "cixl/op.h"
+#include "cixl/slots.h"
+
+#define NO_TAG SIZE_MAX
+
+struct region {
+  size_t end_pc;
+  struct cx_fimp *imp;
+  bool dynamic;
+  struct cx_vec tags;
+};
+
+static bool is_let(struct cx_op *op) {
+  if (op->type != CX_OFUNCALL()) { return false; }
+  struct cx_func *f = op->as_funcall.func;
+  return strcmp(f->lib->id.id, "cx/var") == 0 && strcmp(f->id, "let") == 0;
+}
+
+static ssize_t find_tag(struct region *r, size_t tag) {
+  size_t *t = cx_vec_start(&r->tags);
+  
+  for (size_t i = 0; i < r->tags.count; i++, t++) {
+    if (*t == tag) { return i; }
+  }
+
+  return -1;
+}
+
+static ssize_t add_tag(struct region *r, size_t tag) {
+  ssize_t i = find_tag(r, tag);
+  if (i != -1) { return i; }
+  *(size_t *)cx_vec_push(&r->tags) = tag;
+  return r->tags.count-1;
+}
+
+void cx_alloc_slots(struct cx *cx, struct cx_bin *bin, size_t start_pc) {
+  struct cx_vec rs;
+  cx_vec_init(&rs, sizeof(struct region));
+
+  // Fimp bodies, groups and lambdas each get a scope at runtime with the
+  // enclosing region's scope as parent, except fimps which hang off the
+  // scope they were defined in. Regions calling let dynamically, or
+  // reading a name before binding it, fall back to name lookup.
+  
+  struct region *push(size_t start_pc, size_t end_pc, struct cx_fimp *imp) {
+    struct region *r = cx_vec_push(&rs);
+    r->end_pc = end_pc;
+    r->imp = imp;
+    r->dynamic = false;
+    cx_vec_init(&r->tags, sizeof(size_t));
+
+    struct region reads;
+    cx_vec_init(&reads.tags, sizeof(size_t));
+    
+    for (size_t pc = start_pc; pc < end_pc && !r->dynamic; pc++) {
+      struct cx_op *op = cx_vec_get(&bin->ops, pc);
+      
+      if (is_let(op)) {
+	r->dynamic = true;
+      } else if (op->type == CX_OGETVAR() || op->type == CX_OGETCALL()) {
+	add_tag(&reads, op->as_getvar.id.tag);
+      } else if (op->type == CX_OPUTVAR()) {
+	r->dynamic = find_tag(&reads, op->as_putvar.id.tag) != -1;
+      }
+    }
+
+    cx_vec_deinit(&reads.tags);
+    return r;
+  }
+
+  ssize_t find(struct cx_sym id, unsigned int *depth) {
+    *depth = 0;
+    
+    for (size_t ri = 0; ri < rs.count; ri++) {
+      struct region *r = cx_vec_peek(&rs, ri);
+      if (r->dynamic) { break; }
+      ssize_t i = find_tag(r, id.tag);
+      if (i != -1) { return i; }
+      if (r->imp) { break; }
+      (*depth)++;
+    }
+
+    return -1;
+  }
+  
+  for (size_t pc = start_pc; pc < bin->ops.count; pc++) {
+    while (rs.count) {
+      struct region *r = cx_vec_peek(&rs, 0);
+      if (r->end_pc > pc) { break; }
+      cx_vec_deinit(&r->tags);
+      cx_vec_pop(&rs);
+    }
+
+    struct region *r = rs.count ? cx_vec_peek(&rs, 0) : NULL;
+    if (r && r->dynamic) { r = NULL; }
+    struct cx_op *op = cx_vec_get(&bin->ops, pc);
+    
+    if (op->type == CX_OBEGIN()) {
+      struct cx_fimp *imp = op->as_begin.child ? NULL : op->as_begin.fimp;
+      struct region *fr = push(pc+1, pc+1+op->as_begin.nops, imp);
+      if (!imp) { continue; }
+
+      // Args take the first slots in order, duplicate names would need
+      // overwriting semantics.
+      
+      cx_do_vec(&imp->args, struct cx_arg, a) {
+	size_t tag = a->id ? a->sym_id.tag : NO_TAG;
+
+	if (tag != NO_TAG && find_tag(fr, tag) != -1) {
+	  fr->dynamic = true;
+	  break;
+	}
+
+	*(size_t *)cx_vec_push(&fr->tags) = tag;
+      }
+    } else if (op->type == CX_OLAMBDA()) {
+      push(op->as_lambda.start_op,
+	   op->as_lambda.start_op+op->as_lambda.nops,
+	   NULL);
+    } else if (op->type == CX_OPUTARGS()) {
+      op->as_putargs.slots = r && r->imp == op->as_putargs.imp;
+    } else if (op->type == CX_OPUTVAR()) {
+      op->as_putvar.slot = r ? add_tag(r, op->as_putvar.id.tag) : -1;
+    } else if (op->type == CX_OGETVAR() || op->type == CX_OGETCALL()) {
+      struct cx_getvar_op *g = &op->as_getvar;
+      g->slot = find(g->id, &g->depth);
+    }
+  }
+
+  cx_do_vec(&rs, struct region, r) { cx_vec_deinit(&r->tags); }
+  cx_vec_deinit(&rs);
+}
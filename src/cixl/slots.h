@@ -0,0 +1,11 @@
+#ifndef CX_SLOTS_H
+#define CX_SLOTS_H
+
+#include <stddef.h>
+
+struct cx;
+struct cx_bin;
+
+void cx_alloc_slots(struct cx *cx, struct cx_bin *bin, size_t start_pc);
+
+#endif
@@ -0,0 +1,18 @@
+#include "cixl/box.h"
+#include "cixl/cx.h"
+#include "cixl/pair.h"
+#include "cixl/stack.h"
+#include "cixl/stats.h"
+#include "cixl/type.h"
+
+void cx_push_stat(struct cx_stack *out,
+		  const char *id,
+		  size_t value,
+		  struct cx *cx) {
+  struct cx_pair *p = cx_pair_new(cx, NULL, NULL);
+  cx_box_init(&p->a, cx->sym_type)->as_sym = cx_intern(cx, id);
+  cx_box_init(&p->b, cx->int_type)->as_int = value;
+  
+  cx_box_init(cx_vec_push(&out->imp),
+	      cx_type_get(cx->pair_type, cx->sym_type, cx->int_type))->as_pair = p;
+}
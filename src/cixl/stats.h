@@ -0,0 +1,20 @@
+#ifndef CX_STATS_H
+#define CX_STATS_H
+
+#include <stddef.h>
+
+#ifdef CX_STATS
+#define cx_stat(...) __VA_ARGS__
+#else
+#define cx_stat(...)
+#endif
+
+struct cx;
+struct cx_stack;
+
+void cx_push_stat(struct cx_stack *out,
+		  const char *id,
+		  size_t value,
+		  struct cx *cx);
+
+#endif
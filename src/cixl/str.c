@@ -13,7 +13,7 @@
 struct char_iter {
   struct cx_iter iter;
   struct cx_str *str;
-  char *ptr;
+  size_t i;
 };
 
 static bool char_next(struct cx_iter *iter,
@@ -21,15 +21,15 @@ static bool char_next(struct cx_iter *iter,
 		      struct cx_scope *scope) {
   struct char_iter *it = cx_baseof(iter, struct char_iter, iter);
   
-  if (it->ptr == it->str->data+it->str->len) {
+  if (it->i >= it->str->len) {
     iter->done = true;
     return false;
   }
   
-  unsigned char c = *it->ptr;
+  unsigned char c = it->str->data[it->i];
   
   cx_box_init(out, scope->cx->char_type)->as_char = c;
-  it->ptr++;
+  it->i++;
   return true;
 }
 
@@ -48,20 +48,71 @@ static struct cx_iter *char_iter_new(struct cx_str *str) {
   struct char_iter *it = malloc(sizeof(struct char_iter));
   cx_iter_init(&it->iter, char_iter());
   it->str = cx_str_ref(str);
-  it->ptr = str->data;
+  it->i = 0;
   return &it->iter;
 }
 
-struct cx_str *cx_str_new(const char *data, ssize_t len) {
+// Short strings and slice headers share cx->str_alloc, pooled strings
+// remember their cx to find it when freed.
+
+static struct cx_str *short_new(struct cx *cx) {
+  struct cx_str *str = cx_malloc(&cx->str_alloc);
+  str->cx = cx;
+  return str;
+}
+
+struct cx_str *cx_str_new(struct cx *cx, const char *data, ssize_t len) {
   if (len == -1) { len = strlen(data); }
-  struct cx_str *str = malloc(sizeof(struct cx_str)+len+1);
+  struct cx_str *str = NULL;
+  
+  if (len <= CX_STR_SHORT) {
+    str = short_new(cx);
+  } else {
+    str = malloc(sizeof(struct cx_str)+len+1);
+    str->cx = NULL;
+  }
+  
+  str->data = str->buf;
   if (data) { memcpy(str->data, data, len); }
   str->data[len] = 0;
   str->len = len;
   str->nrefs = 1;
+  str->parent = NULL;
+  return str;
+}
+
+struct cx_str *cx_str_adopt(struct cx *cx, char *data, size_t len) {
+  struct cx_str *str = short_new(cx);
+  str->data = data;
+  str->len = len;
+  str->nrefs = 1;
+  str->parent = NULL;
   return str;
 }
 
+struct cx_str *cx_str_slice(struct cx *cx,
+			    struct cx_str *parent,
+			    size_t start, size_t len) {
+  if (len <= CX_STR_SHORT) { return cx_str_new(cx, parent->data+start, len); }
+  struct cx_str *str = short_new(cx);
+  str->data = parent->data+start;
+  str->len = len;
+  str->nrefs = 1;
+  str->parent = cx_str_ref(parent->parent ? parent->parent : parent);
+  return str;
+}
+
+char *cx_str_cstr(struct cx_str *str) {
+  if (!str->parent) { return str->data; }
+  char *data = (str->len <= CX_STR_SHORT) ? str->buf : malloc(str->len+1);
+  memcpy(data, str->data, str->len);
+  data[str->len] = 0;
+  cx_str_deref(str->parent);
+  str->parent = NULL;
+  str->data = data;
+  return data;
+}
+
 struct cx_str *cx_str_ref(struct cx_str *str) {
   str->nrefs++;
   return str;
@@ -70,7 +121,20 @@ struct cx_str *cx_str_ref(struct cx_str *str) {
 void cx_str_deref(struct cx_str *str) {
   cx_test(str->nrefs);
   str->nrefs--;
-  if (!str->nrefs) { free(str); }
+  
+  if (!str->nrefs) {
+    if (str->parent) {
+      cx_str_deref(str->parent);
+    } else if (str->data != str->buf) {
+      free(str->data);
+    }
+    
+    if (str->cx) {
+      cx_free(&str->cx->str_alloc, str);
+    } else {
+      free(str);
+    }
+  }
 }
 
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
@@ -100,7 +164,7 @@ static void copy_imp(struct cx_box *dst, const struct cx_box *src) {
 }
 
 static void clone_imp(struct cx_box *dst, struct cx_box *src) {
-  dst->as_str = cx_str_new(src->as_str->data, src->as_str->len);
+  dst->as_str = cx_str_new(src->type->lib->cx, src->as_str->data, src->as_str->len);
 }
 
 static void iter_imp(struct cx_box *in, struct cx_box *out) {
@@ -142,7 +206,7 @@ static void write_imp(struct cx_box *v, FILE *out) {
 
 static void dump_imp(struct cx_box *v, FILE *out) {
   struct cx_str *s = v->as_str;
-  fprintf(out, "'%s'", s->data);
+  fprintf(out, "'%s'", cx_str_cstr(s));
 }
 
 static void print_imp(struct cx_box *v, FILE *out) {
@@ -183,7 +247,7 @@ void cx_cstr_cencode(const char *in, size_t len, FILE *out) {
 
 static bool emit_imp(struct cx_box *v, const char *exp, FILE *out) {
   fprintf(out,
-	  "cx_box_init(%s, cx->str_type)->as_str = cx_str_new(\"",
+	  "cx_box_init(%s, cx->str_type)->as_str = cx_str_new(cx, \"",
 	  exp);
   
   cx_cstr_cencode(v->as_str->data, v->as_str->len, out);
@@ -1,16 +1,28 @@
 #ifndef CX_STR_H
 #define CX_STR_H
 
+#include <stdbool.h>
+
+#define CX_STR_SHORT 15
+
 struct cx;
 struct cx_type;
 
 struct cx_str {
+  struct cx *cx;
+  char *data;
   size_t len;
   unsigned int nrefs;
-  char data[];
+  struct cx_str *parent;
+  char buf[];
 };
 
-struct cx_str *cx_str_new(const char *data, ssize_t len);
+struct cx_str *cx_str_new(struct cx *cx, const char *data, ssize_t len);
+struct cx_str *cx_str_adopt(struct cx *cx, char *data, size_t len);
+struct cx_str *cx_str_slice(struct cx *cx,
+			    struct cx_str *parent,
+			    size_t start, size_t len);
+char *cx_str_cstr(struct cx_str *str);
 struct cx_str *cx_str_ref(struct cx_str *str);
 void cx_str_deref(struct cx_str *str);
 enum cx_cmp cx_cmp_str(const void *x, const void *y);
@@ -24,35 +24,116 @@ struct cx_sym *cx_sym_deinit(struct cx_sym *sym) {
   return sym;
 }
 
+struct cx_sym_table *cx_sym_table_init(struct cx_sym_table *t) {
+  t->nslots = CX_SYM_TABLE_MIN;
+  t->slots = calloc(t->nslots, sizeof(struct cx_sym_slot));
+  t->count = t->nlookups = t->nprobes = t->max_probes = 0;
+  return t;
+}
+
+struct cx_sym_table *cx_sym_table_deinit(struct cx_sym_table *t) {
+  for (struct cx_sym_slot *s = t->slots; s < t->slots+t->nslots; s++) {
+    if (s->sym) { free(cx_sym_deinit(s->sym)); }
+  }
+
+  free(t->slots);
+  return t;
+}
+
+static size_t hash_id(const char *id) {
+  size_t h = 14695981039346656037ULL;
+  
+  for (const char *c = id; *c; c++) {
+    h ^= (unsigned char)*c;
+    h *= 1099511628211ULL;
+  }
+
+  return h;
+}
+
+static struct cx_sym_slot *find_slot(struct cx_sym_slot *slots,
+				     size_t nslots,
+				     const char *id,
+				     size_t hash,
+				     size_t *nprobes) {
+  size_t i = hash & (nslots-1), n = 0;
+  struct cx_sym_slot *s = slots+i;
+  
+  for (; s->sym; n++, i = (i+1) & (nslots-1), s = slots+i) {
+    if (s->hash == hash && strcmp(s->sym->id, id) == 0) { break; }
+  }
+
+  *nprobes = n;
+  return s;
+}
+
+static void grow(struct cx_sym_table *t) {
+  size_t nslots = t->nslots*2, n;
+  struct cx_sym_slot *slots = calloc(nslots, sizeof(struct cx_sym_slot));
+
+  for (struct cx_sym_slot *s = t->slots; s < t->slots+t->nslots; s++) {
+    if (s->sym) { *find_slot(slots, nslots, s->sym->id, s->hash, &n) = *s; }
+  }
+
+  free(t->slots);
+  t->slots = slots;
+  t->nslots = nslots;
+}
+
+struct cx_sym *cx_sym_table_get(struct cx_sym_table *t, const char *id) {
+  size_t hash = hash_id(id), n = 0;
+  struct cx_sym_slot *s = find_slot(t->slots, t->nslots, id, hash, &n);
+  t->nlookups++;
+  t->nprobes += n;
+  if (n > t->max_probes) { t->max_probes = n; }
+  if (s->sym) { return s->sym; }
+
+  // Missing ids get an empty sym that the caller is expected to init, syms
+  // are allocated separately to keep pointers stable when growing.
+  
+  if (2*(t->count+1) > t->nslots) {
+    grow(t);
+    s = find_slot(t->slots, t->nslots, id, hash, &n);
+  }
+  
+  s->hash = hash;
+  s->sym = calloc(1, sizeof(struct cx_sym));
+  t->count++;
+  return s->sym;
+}
+
 enum cx_cmp cx_cmp_sym(const void *x, const void *y) {
   const struct cx_sym *xs = x, *ys = y;
   return cx_cmp_int(&xs->tag, &ys->tag);
 }
 
 static void new_imp(struct cx_box *out) {
-  out->as_sym = cx_gsym(out->type->lib->cx, "s");
+  struct cx *cx = out->type->lib->cx;
+  char *id = cx_fmt("s%zd", cx->next_sym_tag);
+  out->as_sym = cx_intern(cx, id);
+  free(id);
 }
 
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
-  return x->as_sym.tag == y->as_sym.tag;
+  return x->as_sym->tag == y->as_sym->tag;
 }
 
 static enum cx_cmp cmp_imp(const struct cx_box *x, const struct cx_box *y) {
-  return cx_cmp_sym(&x->as_sym, &y->as_sym);
+  return cx_cmp_sym(x->as_sym, y->as_sym);
 }
 
 static void dump_imp(struct cx_box *v, FILE *out) {
-  fprintf(out, "`%s", v->as_sym.id);
+  fprintf(out, "`%s", v->as_sym->id);
 }
 
 static void print_imp(struct cx_box *v, FILE *out) {
-  fputs(v->as_sym.id, out);
+  fputs(v->as_sym->id, out);
 }
 
 static bool emit_imp(struct cx_box *v, const char *exp, FILE *out) {
   fprintf(out,
-	  "cx_box_init(%s, cx->sym_type)->as_sym = %s;\n",
-	  exp, v->as_sym.emit_id);
+	  "cx_box_init(%s, cx->sym_type)->as_sym = &%s;\n",
+	  exp, v->as_sym->emit_id);
   return true;
 }
 
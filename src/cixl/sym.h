@@ -6,6 +6,8 @@
 
 #include <cixl/cmp.h>
 
+#define CX_SYM_TABLE_MIN 256
+
 struct cx;
 struct cx_type;
 
@@ -14,9 +16,24 @@ struct cx_sym {
   size_t tag;
 };
 
+struct cx_sym_slot {
+  size_t hash;
+  struct cx_sym *sym;
+};
+
+struct cx_sym_table {
+  struct cx_sym_slot *slots;
+  size_t nslots, count;
+  size_t nlookups, nprobes, max_probes;
+};
+
 struct cx_sym *cx_sym_init(struct cx_sym *sym, const char *id, size_t tag);
 struct cx_sym *cx_sym_deinit(struct cx_sym *sym);
 
+struct cx_sym_table *cx_sym_table_init(struct cx_sym_table *t);
+struct cx_sym_table *cx_sym_table_deinit(struct cx_sym_table *t);
+struct cx_sym *cx_sym_table_get(struct cx_sym_table *t, const char *id);
+
 enum cx_cmp cx_cmp_sym(const void *x, const void *y);
 
 struct cx_type *cx_init_sym_type(struct cx_lib *lib);
@@ -25,10 +25,12 @@ struct cx_task *cx_task_init(struct cx_task *t,
   t->prev_task = NULL;
   t->prev_bin = t->bin = NULL;
   t->prev_pc = t->pc = -1;
+  t->prev_stop_pc = t->stop_pc = -1;
   t->prev_nlibs = t->prev_nscopes = t->prev_ncalls = -1;
   cx_vec_init(&t->libs, sizeof(struct cx_lib *));
   cx_vec_init(&t->scopes, sizeof(struct cx_scope *));
   cx_vec_init(&t->calls, sizeof(struct cx_call));
+  cx_vec_init(&t->arenas, sizeof(struct cx_malloc_arena *));
   cx_ls_init(&t->q);
   cx_copy(&t->action, action);
   return t;
@@ -48,10 +50,15 @@ struct cx_task *cx_task_deinit(struct cx_task *t) {
   cx_vec_deinit(&t->libs);
   cx_vec_deinit(&t->scopes);
   cx_vec_deinit(&t->calls);
+  cx_vec_deinit(&t->arenas);
   return t;
 }
 
+// Tasks keep their own arena stacks, arenas pushed while a task runs
+// would otherwise be popped out of order by whoever runs next.
+
 static void before_run(struct cx_task *t, struct cx *cx) {
+  cx_swap_arenas(cx, &t->arenas);
   t->prev_coro = cx->coro;
   t->prev_task = cx->task;
   cx->task = t;
@@ -59,6 +66,8 @@ static void before_run(struct cx_task *t, struct cx *cx) {
   cx->bin = t->bin;
   t->prev_pc = cx->pc;
   cx->pc = t->pc;
+  t->prev_stop_pc = cx->stop_pc;
+  cx->stop_pc = t->stop_pc;
   t->prev_nlibs = cx->libs.count;
   t->prev_nscopes = cx->scopes.count;
   t->prev_ncalls = cx->ncalls;
@@ -125,12 +134,15 @@ static bool run_next(struct cx_task *t) {
 
 bool cx_task_resched(struct cx_task *t, struct cx_scope *scope) {
   struct cx *cx = scope->cx;
+  cx_swap_arenas(cx, &t->arenas);
   cx->coro = t->prev_coro;
   cx->task = t->prev_task;
   t->bin = cx->bin;
   cx->bin = t->prev_bin;
   t->pc = cx->pc;
   cx->pc = t->prev_pc;
+  t->stop_pc = cx->stop_pc;
+  cx->stop_pc = t->prev_stop_pc;
 
   ssize_t nlibs = cx->libs.count - t->prev_nlibs;
   
@@ -202,10 +214,12 @@ static void *on_start(void *data) {
   atomic_fetch_add(&t->sched->nruns, 1);
   cx_call(&t->action, scope);
 
+  cx_swap_arenas(cx, &t->arenas);
   cx->coro = t->prev_coro;
   cx->task = t->prev_task;
   cx->bin = t->prev_bin;
   cx->pc = t->prev_pc;
+  cx->stop_pc = t->prev_stop_pc;
   while (cx->libs.count > t->prev_nlibs) { cx_pop_lib(cx); }
   while (cx->scopes.count > t->prev_nscopes) { cx_pop_scope(cx, false); }
   while (cx->ncalls > t->prev_ncalls) { cx_test(cx_pop_call(cx)); }
@@ -21,9 +21,10 @@ struct cx_task {
   struct cx_coro *prev_coro;
   struct cx_task *prev_task;
   ssize_t prev_pc, pc;
+  ssize_t prev_stop_pc, stop_pc;
   struct cx_bin *prev_bin, *bin;
   ssize_t prev_nlibs, prev_nscopes, prev_ncalls;
-  struct cx_vec libs, scopes, calls;
+  struct cx_vec libs, scopes, calls, arenas;
 };
 
 
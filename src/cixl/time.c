@@ -6,15 +6,36 @@
 
 #include "cixl/box.h"
 #include "cixl/cx.h"
+#include "cixl/error.h"
 #include "cixl/lib.h"
+#include "cixl/malloc.h"
 #include "cixl/time.h"
 
+struct cx_time *cx_time_new(struct cx *cx, int32_t months, int64_t ns) {
+  struct cx_time *time = cx_time_init(cx_malloc(&cx->time_alloc), months, ns);
+  time->cx = cx;
+  return time;
+}
+
 struct cx_time *cx_time_init(struct cx_time *time, int32_t months, int64_t ns) {
+  time->cx = NULL;
   time->months = months;
   time->ns = ns;
+  time->nrefs = 1;
+  return time;
+}
+
+struct cx_time *cx_time_ref(struct cx_time *time) {
+  time->nrefs++;
   return time;
 }
 
+void cx_time_deref(struct cx_time *time) {
+  cx_test(time->nrefs);
+  time->nrefs--;
+  if (!time->nrefs) { cx_free(&time->cx->time_alloc, time); }
+}
+
 char *cx_time_fmt(struct cx_time *t, const char *fmt) {
   struct tm tm = {0};
 
@@ -43,12 +64,12 @@ char *cx_time_fmt(struct cx_time *t, const char *fmt) {
 }
 
 static bool equid_imp(struct cx_box *x, struct cx_box *y) {
-  struct cx_time *xt = &x->as_time, *yt = &y->as_time;
+  struct cx_time *xt = x->as_time, *yt = y->as_time;
   return xt->months == yt->months && xt->ns == yt->ns;
 }
 
 static enum cx_cmp cmp_imp(const struct cx_box *x, const struct cx_box *y) {
-  const struct cx_time *xt = &x->as_time, *yt = &y->as_time;
+  const struct cx_time *xt = x->as_time, *yt = y->as_time;
   
   if (xt->months < yt->months ||
       (xt->months == yt->months && xt->ns < yt->ns)) {
@@ -64,10 +85,14 @@ static enum cx_cmp cmp_imp(const struct cx_box *x, const struct cx_box *y) {
 }
 
 static bool ok_imp(struct cx_box *v) {
-  struct cx_time *t = &v->as_time;
+  struct cx_time *t = v->as_time;
   return t->months || t->ns;
 }
 
+static void copy_imp(struct cx_box *dst, const struct cx_box *src) {
+  dst->as_time = cx_time_ref(src->as_time);
+}
+
 static void fprint_ns(int64_t ns, FILE *out) {
   int32_t h = ns / CX_HOUR;
   ns %= CX_HOUR;
@@ -82,7 +107,7 @@ static void fprint_ns(int64_t ns, FILE *out) {
 static void write_imp(struct cx_box *v, FILE *out) {
   fputs("([", out);
   
-  struct cx_time *t = &v->as_time;
+  struct cx_time *t = v->as_time;
   
   int32_t y = t->months / 12, m = t->months % 12, d = t->ns / CX_DAY; 
   fprintf(out, "%" PRId32 " %" PRId32 " %" PRId32, y, m, d);
@@ -106,7 +131,7 @@ static void write_imp(struct cx_box *v, FILE *out) {
 
 static void dump_imp(struct cx_box *v, FILE *out) {
   fputs("Time(", out);
-  struct cx_time *t = &v->as_time;
+  struct cx_time *t = v->as_time;
   
   if (t->months) {
     int32_t y = t->months / 12, m = t->months % 12, d = t->ns / CX_DAY; 
@@ -125,7 +150,7 @@ static void dump_imp(struct cx_box *v, FILE *out) {
 }
 
 static void print_imp(struct cx_box *v, FILE *out) {
-  struct cx_time *t = &v->as_time;
+  struct cx_time *t = v->as_time;
   
   if (t->months) {
     int32_t y = t->months / 12, m = t->months % 12, d = t->ns / CX_DAY; 
@@ -141,13 +166,19 @@ static void print_imp(struct cx_box *v, FILE *out) {
   }
 }
 
+static void deinit_imp(struct cx_box *v) {
+  cx_time_deref(v->as_time);
+}
+
 struct cx_type *cx_init_time_type(struct cx_lib *lib) {
   struct cx_type *t = cx_add_type(lib, "Time", lib->cx->cmp_type);
   t->equid = equid_imp;
   t->cmp = cmp_imp;
   t->ok = ok_imp;
+  t->copy = copy_imp;
   t->write = write_imp;
   t->dump = dump_imp;
   t->print = print_imp;
+  t->deinit = deinit_imp;
   return t;
 }
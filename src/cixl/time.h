@@ -10,15 +10,21 @@
 #define CX_HOUR (60*CX_MIN)
 #define CX_DAY (24*CX_HOUR)
 
+struct cx;
 struct cx_lib;
 struct cx_type;
 
 struct cx_time {
-  int32_t months;
+  struct cx *cx;
   int64_t ns;
+  int32_t months;
+  unsigned int nrefs;
 };
 
+struct cx_time *cx_time_new(struct cx *cx, int32_t months, int64_t ns);
 struct cx_time *cx_time_init(struct cx_time *time, int32_t months, int64_t ns);
+struct cx_time *cx_time_ref(struct cx_time *time);
+void cx_time_deref(struct cx_time *time);
 char *cx_time_fmt(struct cx_time *t, const char *fmt);
 
 struct cx_type *cx_init_time_type(struct cx_lib *lib);
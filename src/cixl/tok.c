@@ -23,8 +23,10 @@ struct cx_tok_type *cx_tok_type_init(struct cx_tok_type *type, const char *id) {
 
 struct cx_tok *cx_tok_init(struct cx_tok *tok,
 			   struct cx_tok_type *type,
+			   const char *file,
 			   int row, int col) {
   tok->type = type;
+  tok->file = file;
   tok->row = row;
   tok->col = col;
   return tok;
@@ -114,11 +116,14 @@ static ssize_t id_compile(struct cx_bin *bin, size_t tok_idx, struct cx *cx) {
   char *id = tok->as_ptr;
   
   if (id[0] == '#') {
-    cx_op_new(bin,
-	      CX_OGETCONST(),
-	      tok_idx)->as_getconst.id = cx_sym(cx, id+1);    
+    struct cx_op *op = cx_op_new(bin, CX_OGETCONST(), tok_idx);
+    op->as_getconst.id = cx_sym(cx, id+1);
+    op->as_getconst.lib = NULL;
+    op->as_getconst.epoch = 0;
   } else if (id[0] == '$') {
-    cx_op_new(bin, CX_OGETVAR(), tok_idx)->as_getvar.id = cx_sym(cx, id+1);
+    struct cx_op *op = cx_op_new(bin, CX_OGETVAR(), tok_idx);
+    op->as_getvar.id = cx_sym(cx, id+1);
+    op->as_getvar.slot = -1;
   } else if (isupper(id[0])) {
     struct cx_type *t = cx_get_type(cx, id, false);
     if (!t) { return -1; }
@@ -163,7 +168,7 @@ static ssize_t id_compile(struct cx_bin *bin, size_t tok_idx, struct cx *cx) {
       if (imp) {
 	if (!imp->ptr && !cx_fimp_inline(imp, tok_idx, bin, cx)) { return -1; }
       } else {
-	struct cx_fimp *imp = (f->imps.members.count == 1)
+	imp = (f->imps.members.count == 1)
 	  ? *(struct cx_fimp **)cx_vec_start(&f->imps.members)
 	  : NULL;
 	
@@ -177,6 +182,7 @@ static ssize_t id_compile(struct cx_bin *bin, size_t tok_idx, struct cx *cx) {
 					    tok_idx)->as_funcall;
       op->func = f;
       op->imp = imp;
+      op->cache = imp ? NULL : cx_funcall_cache_new(f);
     }
   }
 
@@ -33,6 +33,7 @@ struct cx_tok_type *cx_tok_type_init(struct cx_tok_type *type, const char *id);
 
 struct cx_tok {
   struct cx_tok_type *type;
+  const char *file;
   int row, col;
 
   union {
@@ -46,6 +47,7 @@ struct cx_tok {
 
 struct cx_tok *cx_tok_init(struct cx_tok *tok,
 			   struct cx_tok_type *type,
+			   const char *file,
 			   int row, int col);
 
 struct cx_tok *cx_tok_deinit(struct cx_tok *tok);
@@ -9,6 +9,22 @@
 #include "cixl/scope.h"
 #include "cixl/type.h"
 
+struct inst {
+  struct cx_type *args[CX_TYPE_MAX_ARGS];
+  struct cx_type *type;
+};
+
+static enum cx_cmp cmp_inst(const void *x, const void *y) {
+  struct cx_type *const *xs = x, *const *ys = y;
+  
+  for (int i = 0; i < CX_TYPE_MAX_ARGS; i++) {
+    enum cx_cmp c = cx_cmp_ptr(xs+i, ys+i);
+    if (c != CX_CMP_EQ) { return c; }
+  }
+
+  return CX_CMP_EQ;
+}
+
 struct cx_type *cx_type_new(struct cx_lib *lib, const char *id) {
   return cx_type_init(malloc(sizeof(struct cx_type)), lib, id);
 }
@@ -31,6 +47,7 @@ struct cx_type *cx_type_init(struct cx_type *type,
   *(struct cx_type **)cx_vec_put(&type->is, type->tag) = type;
 
   cx_vec_init(&type->args, sizeof(struct cx_type *));
+  cx_set_init(&type->insts, sizeof(struct inst), cmp_inst);
   
   type->new = NULL;
   type->eqval = NULL;
@@ -55,6 +72,7 @@ struct cx_type *cx_type_init(struct cx_type *type,
 }
 
 struct cx_type *cx_type_reinit(struct cx_type *type) {
+  type->lib->cx->dispatch_epoch++;
   type->level = 0;
   
   for (size_t i=0; i < type->is.count; i++) {
@@ -62,6 +80,7 @@ struct cx_type *cx_type_reinit(struct cx_type *type) {
   }
 
   cx_vec_clear(&type->args);
+  cx_set_clear(&type->insts);
   
   cx_do_set(&type->parents, struct cx_type *, t) {
     cx_set_delete(&(*t)->children, t);
@@ -91,6 +110,7 @@ void *cx_type_deinit(struct cx_type *type) {
   cx_set_deinit(&type->children);
   cx_vec_deinit(&type->is);
   cx_vec_deinit(&type->args);
+  cx_set_deinit(&type->insts);
   free(type->id);
   free(type->emit_id);
   return ptr;  
@@ -140,6 +160,18 @@ struct cx_type *cx_type_vget(struct cx_type *t, int nargs, struct cx_type *args[
 
   if (is_identical) { return t; }
 
+  // Instances are cached per type on arg pointers, which saves building and
+  // looking up the id for every call.
+  
+  struct cx_type *key[CX_TYPE_MAX_ARGS] = {NULL};
+  struct inst *in = NULL;
+
+  if (nargs <= CX_TYPE_MAX_ARGS) {
+    memcpy(key, args, nargs*sizeof(struct cx_type *));
+    in = cx_set_get(&t->insts, key);
+    if (in) { return in->type; }
+  }
+  
   struct cx_mfile id;
   cx_mfile_open(&id);
   fputs(t->raw->id, id.stream);
@@ -158,7 +190,7 @@ struct cx_type *cx_type_vget(struct cx_type *t, int nargs, struct cx_type *args[
 
   if (tt) {
     free(id.data);
-    return tt;
+    goto exit;
   }
 
   tt = t->type_new
@@ -182,6 +214,13 @@ struct cx_type *cx_type_vget(struct cx_type *t, int nargs, struct cx_type *args[
   }
 
   cx_lib_push_type(t->lib, tt);
+ exit:
+  if (nargs <= CX_TYPE_MAX_ARGS) {
+    in = cx_set_insert(&t->insts, key);
+    memcpy(in->args, key, sizeof(key));
+    in->type = tt;
+  }
+  
   return tt;
 }
 
@@ -229,6 +268,7 @@ void cx_derive(struct cx_type *child, struct cx_type *parent) {
   if (tp) { *tp = child; }
 
   derive(child, parent);
+  child->lib->cx->dispatch_epoch++;
 }
 
 bool cx_is(struct cx_type *child, struct cx_type *parent) {
@@ -5,6 +5,8 @@
 #include <stdio.h>
 #include "cixl/set.h"
 
+#define CX_TYPE_MAX_ARGS 4
+
 #define cx_type_push_args(t, ...) ({				\
       struct cx_type *_args[] = {__VA_ARGS__};			\
       int _nargs = sizeof(_args) / sizeof(struct cx_type *);	\
@@ -32,6 +34,7 @@ struct cx_type {
   struct cx_type *raw;
   struct cx_set parents, children;
   struct cx_vec is, args;
+  struct cx_set insts;
   
   void (*new)(struct cx_box *);
   bool (*eqval)(struct cx_box *, struct cx_box *);
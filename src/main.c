@@ -4,7 +4,9 @@
 #include <signal.h>
 #include <sys/stat.h>
 
+#include "cixl/bench.h"
 #include "cixl/bin.h"
+#include "cixl/cache.h"
 #include "cixl/cx.h"
 #include "cixl/emit.h"
 #include "cixl/error.h"
@@ -13,6 +15,7 @@
 #include "cixl/op.h"
 #include "cixl/repl.h"
 #include "cixl/scope.h"
+#include "cixl/stats.h"
 
 struct cx cx;
 
@@ -29,6 +32,25 @@ static void on_abort(int _) {
 struct cx_bin *bin;
 static void deinit_bin() { cx_bin_deref(bin); }
 
+static const char *prof_path = NULL;
+
+static void dump_prof() {
+  if (cx.prof.active) { cx_prof_stop(&cx.prof); }
+  cx_prof_dump(&cx.prof, stderr);
+  if (!prof_path) { return; }
+  FILE *out = fopen(prof_path, "w");
+  
+  if (!out) {
+    fprintf(stderr, "Failed opening '%s': %d\n", prof_path, errno);
+    return;
+  }
+  
+  cx_prof_fold(&cx.prof, out);
+  fclose(out);
+}
+
+static void dump_pools() { cx_dump_allocs(&cx, stderr); }
+
 int main(int argc, char *argv[]) {
   srand((ptrdiff_t)argv + clock());
 
@@ -49,9 +71,23 @@ int main(int argc, char *argv[]) {
   cx_use(&cx, "cx/io", "include:");
   cx_use(&cx, "cx/meta", "lib:", "use:");
   cx_use(&cx, "cx/sys", "#args", "init:", "link:");
+
+  const char *cache = getenv("CIXL_CACHE"), *tier = getenv("CIXL_TIER");
+  
+  if (tier) {
+    if (!cache) {
+      fputs("Error: CIXL_TIER requires CIXL_CACHE\n", stderr);
+      return -1;
+    }
+    
+    cx.tier_calls = strtoull(tier, NULL, 10);
+    cx.tier_dir = strdup(cache);
+  }
   
   bool emit = false;
   bool compile = false;
+  bool prof = false, bench = false;
+  const char *json_path = NULL, *baseline_path = NULL;
   int argi = 1;
   
   for (; argi < argc && *argv[argi] == '-'; argi++) {
@@ -59,13 +95,32 @@ int main(int argc, char *argv[]) {
       emit = true;
     } else if (strcmp(argv[argi], "-c") == 0) {
       compile = true;
+    } else if (strncmp(argv[argi], "--profile", 9) == 0 &&
+	       (!argv[argi][9] || argv[argi][9] == '=')) {
+      prof = true;
+      if (argv[argi][9]) { prof_path = argv[argi]+10; }
+    } else if (strcmp(argv[argi], "--pool-stats") == 0) {
+      cx_test(atexit(dump_pools) == 0);
+    } else if (strcmp(argv[argi], "--bench") == 0) {
+      bench = true;
+    } else if (strncmp(argv[argi], "--json=", 7) == 0) {
+      json_path = argv[argi]+7;
+    } else if (strncmp(argv[argi], "--baseline=", 11) == 0) {
+      baseline_path = argv[argi]+11;
     } else {
       fprintf(stderr, "Invalid option %s\n", argv[argi]);
       return -1;
     }
   }
   
-  if (argi == argc && !emit) {    
+  if (bench) {
+    if (!cx_bench_files(&cx, argv[0],
+			argv+argi, argc-argi,
+			json_path, baseline_path)) {
+      cx_dump_errors(&cx, stderr);
+      return -1;
+    }
+  } else if (argi == argc && !emit) {    
     cx_repl(&cx, stdin, stdout);
   } else {
     if (emit) {
@@ -96,6 +151,7 @@ int main(int argc, char *argv[]) {
 	      "-Wall -Werror "
 	      "-Wno-unused-label -Wno-unused-function -Wno-unused-variable "
 	      "-Wno-unused-but-set-variable "
+	      cx_stat("-DCX_STATS ")
 	      "- -Bstatic",
 	      cmd.stream);
 
@@ -138,10 +194,41 @@ int main(int argc, char *argv[]) {
       
       char *fn = argv[argi++];
       cx_push_args(&cx, argc-argi, argv+argi);
+
+      if (prof) {
+	if (!cx_prof_start(&cx.prof, CX_PROF_INTERVAL)) {
+	  cx_dump_errors(&cx, stderr);
+	  return -1;
+	}
+	
+	cx_test(atexit(dump_prof) == 0);
+      }
+      
+      cx_cache_eval_t eval = cache ? cx_cache_load(&cx, cache, fn) : NULL;
+      
+      if (eval) {
+	if (!eval(&cx)) {
+	  cx_dump_errors(&cx, stderr);
+	  return -1;
+	}
+
+	return 0;
+      }
+      
       bin = cx_bin_new();
       cx_test(atexit(deinit_bin) == 0);
+      size_t nfiles = cx.load_files.count;
+      
+      if (!cx_load(&cx, fn, bin)) {
+	cx_dump_errors(&cx, stderr);
+	return -1;
+      }
+
+      if (cache && !cx_cache_store(&cx, cache, fn, bin, nfiles)) {
+	cx_dump_errors(&cx, stderr);
+      }
       
-      if (!cx_load(&cx, fn, bin) || !cx_eval(bin, 0, -1, &cx)) {
+      if (!cx_eval(bin, 0, -1, &cx)) {
 	cx_dump_errors(&cx, stderr);
 	return -1;
       }
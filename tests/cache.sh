@@ -0,0 +1,71 @@
+#!/bin/sh
+# Checks CIXL_CACHE hits, misses, invalidation and failed script and tier
+# compiles by counting compiler runs through a gcc wrapper.
+
+set -e
+
+cixl=$(realpath "$1")
+gcc=$(command -v gcc)
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+mkdir "$dir/bin"
+cat > "$dir/bin/gcc" <<EOS
+#!/bin/sh
+echo >> "$dir/gcc.log"
+[ -e "$dir/fail" ] && exit 1
+exec "$gcc" "\$@"
+EOS
+chmod +x "$dir/bin/gcc"
+touch "$dir/gcc.log"
+
+echo "use: cx; include: 'dep.cx'; \$x say" > "$dir/main.cx"
+echo "let: x 42;" > "$dir/dep.cx"
+
+run() {
+    (cd "$dir" && PATH="$dir/bin:$PATH" CIXL_CACHE="$dir/cache" "$cixl" main.cx)
+}
+
+check() {
+    if [ "$1" != "$2" ]; then
+	echo "Check failed: $3, expected '$2', actual '$1'"
+	exit 1
+    fi
+}
+
+ncompiles() {
+    wc -l < "$dir/gcc.log" | tr -d ' '
+}
+
+check "$(run)" 42 "first run"
+check "$(ncompiles)" 0 "first run skips compiler"
+
+check "$(run)" 42 "miss"
+check "$(ncompiles)" 1 "miss compiles"
+
+check "$(run)" 42 "hit"
+check "$(ncompiles)" 1 "hit skips compiler"
+
+echo "let: x 7;" > "$dir/dep.cx"
+check "$(run)" 7 "invalidated"
+check "$(ncompiles)" 2 "invalidation compiles"
+
+touch "$dir/fail"
+echo "let: x 3;" > "$dir/dep.cx"
+check "$(run 2>/dev/null)" 3 "failed compile"
+check "$(ncompiles)" 3 "failed compile runs compiler"
+check "$(run 2>&1)" 3 "failure recorded"
+check "$(ncompiles)" 3 "failure skips compiler"
+
+echo "use: cx; func: inc(x Int)(_ Int) \$x 1 +; 0 5 {inc} times say" > "$dir/tier.cx"
+
+tier() {
+    (cd "$dir" && PATH="$dir/bin:$PATH" CIXL_CACHE="$dir/cache" CIXL_TIER=2 \
+		   "$cixl" tier.cx)
+}
+
+n=$(ncompiles)
+check "$(tier 2>/dev/null)" 5 "failed tier compile"
+check "$(tier 2>/dev/null)" 5 "failed script compile"
+check "$(tier 2>&1)" 5 "failures recorded"
+check "$(ncompiles)" $((n+2)) "failures skip compiler"